@@ -0,0 +1,21 @@
+#version 330 core
+// 两个颜色附件：0 = 反照率，1 = 局部空间法线 (编码到 [0,1])
+layout (location = 0) out vec4 AlbedoOut;
+layout (location = 1) out vec4 NormalOut;
+
+in vec3 Normal;
+in vec2 TexCoords;
+in vec3 VertColor;
+
+uniform sampler2D texture_diffuse1;
+
+void main()
+{
+    // 与 lighting_fs 一致：纹理颜色 * 顶点颜色，透明部分直接丢弃
+    vec4 texData = texture(texture_diffuse1, TexCoords);
+    if(texData.a < 0.1) discard;
+
+    // alpha = 1 标记被覆盖的像素，未覆盖处保持清屏的 0
+    AlbedoOut = vec4(vec3(texData) * VertColor, 1.0);
+    NormalOut = vec4(normalize(Normal) * 0.5 + 0.5, 1.0);
+}
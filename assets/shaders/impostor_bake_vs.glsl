@@ -0,0 +1,22 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 3) in vec3 aColor;
+
+out vec3 Normal;
+out vec2 TexCoords;
+out vec3 VertColor;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+void main() {
+    // 法线保持在模型局部空间，绘制替身时再用 model 矩阵变换到世界空间
+    Normal = mat3(transpose(inverse(model))) * aNormal;
+    TexCoords = aTexCoords;
+    VertColor = aColor;
+
+    gl_Position = projection * view * model * vec4(aPos, 1.0);
+}
@@ -0,0 +1,86 @@
+#version 330 core
+out vec4 FragColor;
+
+struct DirLight {
+    vec3 direction;
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+// 成员顺序按 std140 排列：每个 vec3 后面正好塞一个 float
+struct PointLight {
+    vec3 position;
+    float constant;
+    vec3 ambient;
+    float linear;
+    vec3 diffuse;
+    float quadratic;
+    vec3 specular;
+};
+
+#define NR_POINT_LIGHTS 16
+
+in vec3 FragPos;
+in vec2 TexCoords;
+
+uniform mat4 model;
+// 光照数据 (UBO，绑定点 1，只在灯光变化时更新)
+layout (std140) uniform LightData {
+    DirLight dirLight;
+    PointLight pointLights[NR_POINT_LIGHTS];
+    int nr_point_lights;
+};
+// 天体自发光：开启时替换方向光的 ambient/diffuse (光照 UBO 是共享的，不能为单个物体修改)
+uniform bool emissive;
+uniform vec3 emissionAmbient;
+uniform vec3 emissionDiffuse;
+
+uniform sampler2D impostorAlbedo;
+uniform sampler2D impostorNormal;
+
+// 远景只保留漫反射 + 环境光：高光和阴影在这个距离上几乎看不出来
+vec3 CalcDirLight(DirLight light, vec3 normal, vec3 albedo)
+{
+    vec3 lightDir = normalize(-light.direction);
+    float diff = max(dot(normal, lightDir), 0.0);
+    return light.ambient * albedo + light.diffuse * diff * albedo;
+}
+
+vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 albedo)
+{
+    vec3 lightDir = normalize(light.position - fragPos);
+    float diff = max(dot(normal, lightDir), 0.0);
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    return (light.ambient * albedo + light.diffuse * diff * albedo) * attenuation;
+}
+
+void main()
+{
+    vec4 albedoData = texture(impostorAlbedo, TexCoords);
+    // mipmap 会把边缘的 alpha 变成小数，取 0.5 作为轮廓
+    if(albedoData.a < 0.5) discard;
+
+    // mipmap 混入了清屏的黑色，除以 alpha 还原颜色 (法线同理)
+    vec3 albedo = albedoData.rgb / albedoData.a;
+
+    vec4 normalData = texture(impostorNormal, TexCoords);
+    vec3 localNormal = normalData.xyz / normalData.a * 2.0 - 1.0;
+    vec3 norm = normalize(mat3(transpose(inverse(model))) * localNormal);
+
+    DirLight mainLight = dirLight;
+    if (emissive) {
+        mainLight.ambient = emissionAmbient;
+        mainLight.diffuse = emissionDiffuse;
+    }
+
+    vec3 result = CalcDirLight(mainLight, norm, albedo);
+    for(int i = 0; i < nr_point_lights; i++)
+    result += CalcPointLight(pointLights[i], norm, FragPos, albedo);
+
+    result = pow(result, vec3(1.0 / 2.2));
+
+    FragColor = vec4(result, 1.0);
+}
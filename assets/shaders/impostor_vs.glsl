@@ -0,0 +1,30 @@
+#version 330 core
+layout (location = 0) in vec2 aCorner; // [-1, 1]^2 面片顶点
+
+out vec3 FragPos;
+out vec2 TexCoords;
+
+uniform mat4 model;
+// 每帧数据 (UBO，绑定点 0，布局见 UniformBlocks.h)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos; // xyz 有效
+};
+
+// 当前帧在模型局部空间中的摆放 (right/up 已乘上包围球半径)
+uniform vec3 impostorCenter;
+uniform vec3 impostorRight;
+uniform vec3 impostorUp;
+// 当前帧在图集中的位置
+uniform vec2 frameOffset;
+uniform float frameScale;
+
+void main() {
+    vec3 localPos = impostorCenter + impostorRight * aCorner.x + impostorUp * aCorner.y;
+    FragPos = vec3(model * vec4(localPos, 1.0));
+    TexCoords = frameOffset + (aCorner * 0.5 + 0.5) * frameScale;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
@@ -1,4 +1,6 @@
 #version 330 core
+// 变体开关 (由 ShaderLibrary 注入 #define)：
+// HAS_SHADOWS / NUM_POINT_LIGHTS=N / ALPHA_TEST / HAS_SPECULAR_MAP / HAS_SPOT
 out vec4 FragColor;
 
 struct Material {
@@ -9,7 +11,9 @@ struct Material {
 
 // 放在外面，直接对应 Assimp 的命名惯例
 uniform sampler2D texture_diffuse1;
+#ifdef HAS_SPECULAR_MAP
 uniform sampler2D texture_specular1;
+#endif
 
 struct DirLight {
     vec3 direction;
@@ -19,18 +23,18 @@ struct DirLight {
     vec3 specular;
 };
 
+// 成员顺序按 std140 排列：每个 vec3 后面正好塞一个 float
 struct PointLight {
     vec3 position;
-
     float constant;
-    float linear;
-    float quadratic;
-
     vec3 ambient;
+    float linear;
     vec3 diffuse;
+    float quadratic;
     vec3 specular;
 };
 
+#ifdef HAS_SPOT
 struct SpotLight {
     vec3 position;
     vec3 direction;
@@ -45,6 +49,7 @@ struct SpotLight {
     vec3 diffuse;
     vec3 specular;
 };
+#endif
 
 #define NR_POINT_LIGHTS 16
 
@@ -52,23 +57,50 @@ in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
 in vec3 VertColor; // 接收来自 C++ 的顶点颜色
+#ifdef HAS_SHADOWS
 // 接收光空间坐标
 in vec4 FragPosLightSpace;
-
-uniform vec3 viewPos;
-uniform DirLight dirLight;
-uniform PointLight pointLights[NR_POINT_LIGHTS];
+#endif
+
+// 每帧数据 (UBO，绑定点 0，布局见 UniformBlocks.h)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos; // xyz 有效
+};
+// 光照数据 (UBO，绑定点 1，只在灯光变化时更新)
+layout (std140) uniform LightData {
+    DirLight dirLight;
+    PointLight pointLights[NR_POINT_LIGHTS];
+    int nr_point_lights;
+};
+// 天体自发光：开启时替换方向光的 ambient/diffuse (光照 UBO 是共享的，不能为单个物体修改)
+uniform bool emissive;
+uniform vec3 emissionAmbient;
+uniform vec3 emissionDiffuse;
+#ifdef HAS_SPOT
 uniform SpotLight spotLight;
+#endif
 uniform Material material;
+#ifdef HAS_SHADOWS
 // 阴影贴图采样器
 uniform sampler2D shadowMap;
-uniform int nr_point_lights;
+// 不接收阴影的物体 (例如自己发光的篝火) 设为 false
+uniform bool receiveShadows = true;
+#endif
+
+// 高光颜色 (main 里采样一次)
+vec3 specularColor;
 // function prototypes
 // CalcDirLight 增加 shadow 参数
 vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, vec3 albedo, float shadow);
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo);
+#ifdef HAS_SPOT
 vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo);
+#endif
 
+#ifdef HAS_SHADOWS
 // 阴影计算函数
 float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
 {
@@ -102,32 +134,58 @@ float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
 
     return shadow;
 }
+#endif
 
 void main()
 {
     vec3 norm = normalize(Normal);
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
     // 预先计算反照率(Albedo):最终基础色 = 纹理采样颜色 * 顶点颜色
     // 对于 Steve: texture(皮肤) * vec3(1,1,1) = 皮肤
     // 对于 钻石剑: texture(白色) * vec3(0,0.5,0.7) = 蓝色
     vec4 texData = texture(texture_diffuse1, TexCoords);
 
+#ifdef ALPHA_TEST
     // 透明度测试 (解决 Steve 帽子层遮挡问题)
     if(texData.a < 0.1) discard;
+#endif
 
     vec3 albedo = vec3(texData) * VertColor;
 
+#ifdef HAS_SPECULAR_MAP
+    specularColor = vec3(texture(texture_specular1, TexCoords));
+#else
+    // 没有高光贴图时沿用漫反射贴图 (和以前采样器默认指向 0 号纹理单元的效果一致)
+    specularColor = vec3(texData);
+#endif
+
+#ifdef HAS_SHADOWS
     // 计算阴影 (只针对方向光), 传入 normal 和 光线反方向 (指向光源)
-    float shadow = ShadowCalculation(FragPosLightSpace, norm, normalize(-dirLight.direction));
+    float shadow = receiveShadows ? ShadowCalculation(FragPosLightSpace, norm, normalize(-dirLight.direction)) : 0.0;
+#else
+    float shadow = 0.0;
+#endif
+
+    DirLight mainLight = dirLight;
+    if (emissive) {
+        mainLight.ambient = emissionAmbient;
+        mainLight.diffuse = emissionDiffuse;
+    }
 
     // 将 albedo 传递给光照计算函数，避免在每个函数里重复采样和相乘
     // phase 1: directional lighting
-    vec3 result = CalcDirLight(dirLight, norm, viewDir, albedo, shadow);
-    // phase 2: point lights
+    vec3 result = CalcDirLight(mainLight, norm, viewDir, albedo, shadow);
+    // phase 2: point lights (个数固定时循环可以展开)
+#ifdef NUM_POINT_LIGHTS
+    for(int i = 0; i < NUM_POINT_LIGHTS; i++)
+#else
     for(int i = 0; i < nr_point_lights; i++)
+#endif
     result += CalcPointLight(pointLights[i], norm, FragPos, viewDir, albedo);
+#ifdef HAS_SPOT
     // phase 3: spot light
     result += CalcSpotLight(spotLight, norm, FragPos, viewDir, albedo);
+#endif
 
     result = pow(result, vec3(1.0 / 2.2));
 
@@ -146,7 +204,7 @@ vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, vec3 albedo, float
 
     vec3 ambient = light.ambient * albedo;
     vec3 diffuse = light.diffuse * diff * albedo;
-    vec3 specular = light.specular * spec * vec3(texture(texture_specular1, TexCoords));
+    vec3 specular = light.specular * spec * specularColor;
 
     // 阴影只影响漫反射和高光，不影响环境光
     return (ambient + (1.0 - shadow) * (diffuse + specular));
@@ -168,7 +226,7 @@ vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, v
     vec3 ambient = light.ambient * albedo;
     vec3 diffuse = light.diffuse * diff * albedo;
 //    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
-    vec3 specular = light.specular * spec * vec3(texture(texture_specular1, TexCoords));
+    vec3 specular = light.specular * spec * specularColor;
 
     ambient *= attenuation;
     diffuse *= attenuation;
@@ -176,6 +234,7 @@ vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, v
     return (ambient + diffuse + specular);
 }
 
+#ifdef HAS_SPOT
 vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo)
 {
     vec3 lightDir = normalize(light.position - fragPos);
@@ -197,10 +256,11 @@ vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec
     vec3 ambient = light.ambient * albedo;
     vec3 diffuse = light.diffuse * diff * albedo;
 //    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
-    vec3 specular = light.specular * spec * vec3(texture(texture_specular1, TexCoords));
+    vec3 specular = light.specular * spec * specularColor;
 
     ambient *= attenuation * intensity;
     diffuse *= attenuation * intensity;
     specular *= attenuation * intensity;
     return (ambient + diffuse + specular);
-}
\ No newline at end of file
+}
+#endif
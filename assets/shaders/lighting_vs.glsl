@@ -8,20 +8,36 @@ out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
 out vec3 VertColor; // [新输出]
+#ifdef HAS_SHADOWS
 out vec4 FragPosLightSpace;
+#endif
 
+#ifdef INSTANCED
+// 每实例的模型矩阵 (占用 Layout 4~7，见 TriMesh::drawInstanced)
+layout (location = 4) in mat4 aInstanceModel;
+#else
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform mat4 lightSpaceMatrix;
+#endif
+// 每帧数据 (UBO，绑定点 0，布局见 UniformBlocks.h)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos; // xyz 有效
+};
 
 void main() {
+#ifdef INSTANCED
+    mat4 model = aInstanceModel;
+#endif
     FragPos = vec3(model * vec4(aPos, 1.0));
     Normal = mat3(transpose(inverse(model))) * aNormal;
     TexCoords = aTexCoords;
     VertColor = aColor; // 透传
 
+#ifdef HAS_SHADOWS
     FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
+#endif
 
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
\ No newline at end of file
@@ -1,10 +1,23 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 
-uniform mat4 lightSpaceMatrix;
+// 每帧数据 (UBO，绑定点 0，布局见 UniformBlocks.h)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos;
+};
+#ifdef INSTANCED
+layout (location = 4) in mat4 aInstanceModel;
+#else
 uniform mat4 model;
+#endif
 
 void main()
 {
+#ifdef INSTANCED
+    mat4 model = aInstanceModel;
+#endif
     gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
 }
\ No newline at end of file
@@ -3,13 +3,19 @@ layout (location = 0) in vec3 aPos;
 
 out vec3 TexCoords;
 
-uniform mat4 projection;
-uniform mat4 view;
+// 每帧数据 (UBO，绑定点 0，布局见 UniformBlocks.h)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos; // xyz 有效
+};
 
 void main()
 {
     TexCoords = aPos;
-    vec4 pos = projection * view * vec4(aPos, 1.0);
+    // 去掉 View 矩阵的平移部分：天空盒只随旋转而旋转
+    vec4 pos = projection * mat4(mat3(view)) * vec4(aPos, 1.0);
     // 让天空盒的深度永远是 1.0 (最大深度)
     gl_Position = pos.xyww;
 }
\ No newline at end of file
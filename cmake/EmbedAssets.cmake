@@ -0,0 +1,43 @@
+# 把资源文件转成编译进可执行文件的字节数组 (以脚本模式运行: cmake -P)
+#
+# 参数:
+#   EMBED_ROOT    资源路径相对于这个目录登记 (通常是源码根目录)
+#   EMBED_FILES   要嵌入的文件，用 "|" 分隔 (";" 在 add_custom_command 里会被拆开)
+#   EMBED_OUTPUT  生成的 .cpp 路径
+#
+# 生成的文件定义 EmbeddedAssets::ENTRIES / ENTRY_COUNT (见 include/Core/EmbeddedAssets.h)
+
+string(REPLACE "|" ";" files "${EMBED_FILES}")
+
+# CMake 的正则不支持 {n}，手动拼出 "16 个字节" 的模式
+string(REPEAT "0x[0-9a-f][0-9a-f]," 16 line_pattern)
+
+set(arrays "")
+set(entries "")
+set(count 0)
+foreach(file IN LISTS files)
+	if(NOT EXISTS "${file}")
+		message(FATAL_ERROR "EmbedAssets: missing file ${file}")
+	endif()
+	file(RELATIVE_PATH key "${EMBED_ROOT}" "${file}")
+	file(READ "${file}" hex HEX)
+	file(SIZE "${file}" size)
+	# 每 16 字节换一行，保持生成文件可读
+	string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+	string(REGEX REPLACE "(${line_pattern})" "\\1\n    " bytes "${bytes}")
+	if(size EQUAL 0)
+		set(bytes "0x00,")
+	endif()
+	string(APPEND arrays "// ${key}\nalignas(16) static constexpr unsigned char asset${count}[] = {\n    ${bytes}\n};\n\n")
+	string(APPEND entries "    {\"${key}\", asset${count}, ${size}},\n")
+	math(EXPR count "${count} + 1")
+endforeach()
+
+if(count EQUAL 0)
+	# 没有嵌入任何文件时也要有一个合法的数组
+	set(entries "    {nullptr, nullptr, 0},\n")
+endif()
+
+set(content "// 由 cmake/EmbedAssets.cmake 生成，不要手动修改\n#include \"Core/EmbeddedAssets.h\"\n\nnamespace EmbeddedAssets {\n\n${arrays}const Entry ENTRIES[] = {\n${entries}};\n\nconst size_t ENTRY_COUNT = ${count};\n\n} // namespace EmbeddedAssets\n")
+
+file(WRITE "${EMBED_OUTPUT}" "${content}")
@@ -0,0 +1,30 @@
+#ifndef EMBEDDEDASSETS_H
+#define EMBEDDEDASSETS_H
+
+#include <cstddef>
+#include <string>
+
+// 编译进可执行文件的资源 (着色器、窗口图标等启动必需的小文件)
+// 表由构建时的 cmake/EmbedAssets.cmake 生成，键是相对于源码根目录的路径，例如 "assets/shaders/lighting_fs.glsl"
+// 读取资源时先查这里，查不到再读磁盘
+namespace EmbeddedAssets {
+
+struct Entry {
+    const char* path;
+    const unsigned char* data;
+    size_t size;
+};
+
+// 生成文件中定义
+extern const Entry ENTRIES[];
+extern const size_t ENTRY_COUNT;
+
+// 没有嵌入时返回 nullptr
+const Entry* find(const std::string& path);
+
+// 先查嵌入表，没有再读磁盘；都失败返回 false
+bool readText(const std::string& path, std::string& out);
+
+} // namespace EmbeddedAssets
+
+#endif
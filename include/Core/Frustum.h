@@ -0,0 +1,38 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "Core/AABB.h"
+
+// 批量剔除用的包围盒列表 (SoA：每个分量一个数组，SIMD 一次读 4 个盒子)
+struct BoundsList {
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ; // 半边长
+
+    void clear();
+    void push(const AABB& box);
+    size_t size() const { return centerX.size(); }
+};
+
+// 视锥体：6 个平面 (xyz 为朝内的单位法线，点 p 在内侧时 dot(n, p) + w >= 0)
+struct Frustum {
+    glm::vec4 planes[6];
+
+    // 从 projection * view 的行向量提取 (Gribb-Hartmann)，平面已归一化
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+
+    // 包围盒与视锥相交或在内部 (保守判断：只剔除完全在某个平面外侧的盒子)
+    bool intersects(const AABB& box) const;
+
+    // 去掉近平面，视锥朝近处无限延伸
+    // 用于阴影：光源和阴影体积之间的遮挡物不在体积内，却仍然会把影子投进来
+    void removeNearPlane() { planes[4] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f); }
+
+    // 批量判断，visible[i] 写 1 (可见) 或 0，判断方式与 intersects 相同
+    // 支持 SSE 时每次处理 4 个盒子
+    void cull(const BoundsList& boxes, std::vector<uint8_t>& visible) const;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef GLEXTENSIONS_H
+#define GLEXTENSIONS_H
+
+#include "Vendor/glad/glad.h"
+
+// glad 只生成了 3.3 Core，没有任何扩展，这里补上需要用到的扩展枚举并做运行时检测
+// 需要在 OpenGL 上下文创建之后调用
+
+// GL_EXT_texture_compression_s3tc
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+// GL_ARB_get_program_binary (4.1 核心)
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile (两者枚举值相同)
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+namespace GLExtensions {
+
+// 扩展函数不在 glad 里，需要自己用 glfwGetProcAddress 取
+struct ProgramBinaryApi {
+    void (APIENTRYP getProgramBinary)(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+    void (APIENTRYP programBinary)(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+    void (APIENTRYP programParameteri)(GLuint program, GLenum pname, GLint value);
+};
+
+// 当前上下文是否支持某个扩展 (结果在第一次调用时缓存)
+bool has(const char *name);
+
+// BC1/BC3 (S3TC)。RGTC (BC4/BC5) 在 3.0 以后已经是核心功能，不需要检测
+bool hasS3TC();
+
+// 程序二进制 (4.1 或 GL_ARB_get_program_binary，且驱动至少支持一种二进制格式)
+// 不支持时返回 nullptr
+const ProgramBinaryApi *getProgramBinaryApi();
+
+// 并行编译着色器 (GL_KHR_parallel_shader_compile 或 GL_ARB_parallel_shader_compile)
+// 第一次调用时用 glMaxShaderCompilerThreadsKHR 让驱动自行决定编译线程数
+// 支持时可以用 GL_COMPLETION_STATUS_KHR 非阻塞地查询编译/链接是否结束
+bool enableParallelShaderCompile();
+
+} // namespace GLExtensions
+
+#endif
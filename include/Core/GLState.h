@@ -0,0 +1,47 @@
+#ifndef GLSTATE_H
+#define GLSTATE_H
+
+#include "Vendor/glad/glad.h"
+#include <cstdint>
+
+// GL 状态缓存：记住当前的程序 / VAO / 纹理 / FBO / 深度函数，和当前值相同的调用直接跳过
+// Core/ 和 Game/ 里所有这类调用都必须经过这里，否则缓存会和驱动不一致
+// 只在 GL 线程使用
+//
+// 绘制之后不再把 VAO 解绑回 0：所有修改 VAO 状态的代码 (上传网格、配置实例属性) 都会先绑定自己的 VAO
+namespace GLState {
+
+// 一帧内的调用次数
+struct Counters {
+    uint32_t issued = 0; // 真正交给驱动的
+    uint32_t elided = 0; // 状态已经是目标值而跳过的
+};
+
+void useProgram(GLuint program);
+void bindVertexArray(GLuint vao);
+// unit 为 GL_TEXTURE0 + n
+void activeTexture(GLenum unit);
+// 绑定到当前活动的纹理单元
+void bindTexture(GLenum target, GLuint texture);
+// 绑定到指定单元 (unit 从 0 开始)：该单元已经是这张纹理时，连 glActiveTexture 也省掉
+void bindTextureUnit(GLuint unit, GLenum target, GLuint texture);
+// GL_FRAMEBUFFER 同时设置读和写
+void bindFramebuffer(GLenum target, GLuint framebuffer);
+void depthFunc(GLenum func);
+
+// 删除对象并从缓存里清掉 (GL 会回收名字，之后新建的对象可能拿到同一个名字)
+void deleteProgram(GLuint program);
+void deleteVertexArrays(GLsizei count, const GLuint *vaos);
+void deleteTextures(GLsizei count, const GLuint *textures);
+void deleteFramebuffers(GLsizei count, const GLuint *framebuffers);
+
+// 绕过缓存改了状态之后调用 (例如 ImGui 的渲染后端)，之后的每类调用都会真正下发一次
+void invalidate();
+
+// 每帧开始时调用：保存上一帧的计数并清零
+void beginFrame();
+const Counters &getLastFrameCounters();
+
+} // namespace GLState
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef IMPOSTOR_H
+#define IMPOSTOR_H
+
+#include "Vendor/glad/glad.h"
+#include <glm/glm.hpp>
+
+#include "Core/Shader.h"
+
+class TriMesh;
+
+// 远景替身 (Impostor)
+// 加载时把模型从 gridSize x gridSize 个方向 (八面体映射，覆盖整个球面) 渲染进一张图集，
+// 远处绘制时只画一个面片，根据相机方向挑选最接近的那一帧
+// 图集同时保存反照率和局部空间法线，所以替身仍然可以接受方向光/点光源
+class Impostor {
+public:
+    Impostor();
+    ~Impostor();
+
+    Impostor(const Impostor &) = delete;
+    Impostor &operator=(const Impostor &) = delete;
+
+    // bakeShader: impostor_bake 着色器 (输出反照率 + 法线两个颜色附件)
+    // frameSize: 每一帧的像素边长，图集大小为 gridSize * frameSize
+    bool bake(TriMesh &mesh, const Shader &bakeShader, int gridSize = 8, int frameSize = 128);
+    bool isReady() const { return albedoTexture != 0; }
+
+    // 绘制替身面片：shader 为 impostor 着色器，view/projection 与光照参数由调用者提前设置
+    void draw(const Shader &shader, const glm::mat4 &model, const glm::vec3 &cameraPos) const;
+
+private:
+    GLuint albedoTexture;
+    GLuint normalTexture;
+    GLuint quadVAO, quadVBO;
+
+    int gridSize;
+    glm::vec3 center; // 局部空间包围球
+    float radius;
+
+    // 八面体映射：单位方向 <-> [0,1]^2
+    static glm::vec2 octEncode(const glm::vec3 &dir);
+    static glm::vec3 octDecode(const glm::vec2 &uv);
+    // 某一帧的拍摄方向 (从物体指向相机) 对应的屏幕右/上方向，烘焙和绘制必须一致
+    static void frameBasis(const glm::vec3 &dir, glm::vec3 &right, glm::vec3 &up);
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef INSTANCEBUFFER_H
+#define INSTANCEBUFFER_H
+
+#include "Vendor/glad/glad.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+// 每实例模型矩阵的顶点缓冲 (着色器端 Layout 4~7，见 TriMesh::drawInstanced)
+// GL 对象在第一次 upload 时才创建 (构造时可能还没有 GL 上下文)
+class InstanceBuffer {
+public:
+    InstanceBuffer() = default;
+    ~InstanceBuffer() {
+        if (id) glDeleteBuffers(1, &id);
+    }
+
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+    // 整块重写：先孤立旧存储 (驱动可能还在用上一个 Pass 的数据)，再写入
+    // 容量按 2 倍增长，之后大小不变，驱动可以复用同一块存储
+    void upload(const std::vector<glm::mat4>& matrices) {
+        if (matrices.empty()) return;
+        if (!id) glGenBuffers(1, &id);
+
+        glBindBuffer(GL_ARRAY_BUFFER, id);
+        if (matrices.size() > capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            while (capacity < matrices.size()) capacity *= 2;
+        }
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, matrices.size() * sizeof(glm::mat4), matrices.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    GLuint getID() const { return id; }
+
+private:
+    GLuint id = 0;
+    size_t capacity = 0; // 以矩阵个数计
+};
+
+#endif
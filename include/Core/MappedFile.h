@@ -0,0 +1,41 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// 只读内存映射文件 (RAII)
+// 用于直接把烘焙好的二进制资源映射进地址空间，避免 read + 拷贝
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    // 禁止拷贝，允许移动
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // 映射整个文件，失败返回 false
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    const unsigned char* getData() const { return static_cast<const unsigned char*>(data); }
+    size_t getSize() const { return size; }
+
+private:
+    void* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+// 烘焙文件 (.smesh / .stex) 存在且不比源文件旧时才使用
+// 源文件不存在 (只发布了烘焙文件) 时直接使用烘焙文件
+bool isCookedFresh(const std::string& cookedPath, const std::string& sourcePath);
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef MESHFILE_H
+#define MESHFILE_H
+
+#include <cstdint>
+#include <string>
+
+// 烘焙网格格式 (.smesh)
+// 布局: [Header][MaterialEntry * materialCount][LodEntry * lodCount][顶点数据][索引数据]
+// 顶点/索引数据与 TriMesh 上传到 VBO/EBO 的字节完全一致，加载时 mmap 后直接交给 glBufferData
+namespace MeshFile {
+
+constexpr char MAGIC[4] = {'S', 'M', 'S', 'H'};
+// v4: 烘焙数据已经过 MeshOptimizer 重排，旧版本文件需要重新烘焙
+// v5: 增加 LOD 表，索引块中依次存放各级 LOD 的索引
+// v6: 增加 flags (记录加载时的可选处理)
+constexpr uint32_t VERSION = 6;
+
+// Header::flags
+constexpr uint32_t FLAG_MERGED_COPLANAR = 1u << 0; // 经过 QuadMerger 共面合并
+
+// 各数据块的起始偏移按 16 字节对齐
+constexpr uint64_t BLOCK_ALIGNMENT = 16;
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+
+    uint32_t vertexCount;
+    uint32_t indexCount;   // 所有 LOD 的索引总数
+    uint32_t materialCount;
+    uint32_t indexSize;    // 2 (GL_UNSIGNED_SHORT) 或 4 (GL_UNSIGNED_INT)
+    uint32_t vertexFormat; // VertexFormat (交错布局，步长由格式决定)
+    uint32_t lodCount;
+    uint32_t flags;        // FLAG_*
+    uint32_t reserved;
+
+    // 局部坐标系包围盒
+    float minBound[3];
+    float maxBound[3];
+
+    uint64_t materialOffset;
+    uint64_t vertexOffset;
+    uint64_t vertexBytes;
+    uint64_t indexOffset;
+    uint64_t indexBytes;
+    uint64_t lodOffset;
+};
+
+// 材质表：记录需要加载的贴图 (路径相对于模型所在目录)
+struct MaterialEntry {
+    char type[32];  // texture_diffuse / texture_specular
+    char path[224];
+};
+
+// LOD 表：每一级在索引块中的范围
+struct LodEntry {
+    uint32_t indexOffset;
+    uint32_t indexCount;
+    float error;
+    uint32_t reserved;
+};
+
+inline uint64_t alignOffset(uint64_t offset) {
+    return (offset + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+}
+
+// assets/models/rock/model.obj -> assets/models/rock/model.smesh
+inline std::string getCookedPath(const std::string& sourcePath) {
+    size_t dot = sourcePath.find_last_of('.');
+    size_t slash = sourcePath.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return sourcePath + ".smesh";
+    }
+    return sourcePath.substr(0, dot) + ".smesh";
+}
+
+} // namespace MeshFile
+
+#endif
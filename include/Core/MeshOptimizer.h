@@ -0,0 +1,28 @@
+#ifndef MESHOPTIMIZER_H
+#define MESHOPTIMIZER_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// 网格后处理：提高 GPU 顶点缓存命中率、减少过度绘制、改善顶点读取局部性
+// 所有函数都作用于三角形列表索引 (每 3 个索引一个三角形)
+namespace MeshOptimizer {
+
+// ACMR (Average Cache Miss Ratio)：每个三角形平均产生的顶点缓存未命中数
+// 用 FIFO 缓存模拟，理想值约 0.5，完全无复用时为 3.0
+float computeACMR(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize = 16);
+
+// 顶点缓存优化 (Tom Forsyth 线性速度算法)：重排三角形顺序，不改变顶点
+void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount);
+
+// 过度绘制优化：在缓存优化后的序列里按"硬边界"切分簇，
+// 再把朝外的簇排到前面，让它们先写入深度 (Sander et al. 2007 的简化版)
+void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<glm::vec3>& positions);
+
+// 顶点读取优化：按首次使用顺序重排顶点，返回 旧索引 -> 新索引 的映射
+// 未被引用的顶点映射为 ~0u (调用者据此丢弃)，indices 会被就地改写
+std::vector<unsigned int> optimizeVertexFetch(std::vector<unsigned int>& indices, size_t vertexCount);
+
+} // namespace MeshOptimizer
+
+#endif
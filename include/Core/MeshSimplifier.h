@@ -0,0 +1,27 @@
+#ifndef MESHSIMPLIFIER_H
+#define MESHSIMPLIFIER_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// 网格简化：基于二次误差度量 (Garland & Heckbert 1997) 的边折叠，用于生成 LOD
+// 只把顶点折叠到已有顶点上，不产生新顶点，结果索引可以与原网格共用同一个 VBO
+namespace MeshSimplifier {
+
+// indices: 三角形列表；顶点属性数组与 TriMesh 的 vertex_* 一一对应
+// 折叠按位置进行 (UV/法线接缝两侧的顶点视为同一个位置)，
+// 输出时为每个角挑选折叠目标位置上属性最接近的原顶点
+// targetIndexCount: 期望的索引数，达到后停止
+// targetError: 允许的最大几何误差，相对于包围盒对角线长度 (例如 0.01 = 1%)
+// resultError: 可选，返回实际达到的相对误差
+std::vector<unsigned int> simplify(const std::vector<unsigned int>& indices,
+                                   const std::vector<glm::vec3>& positions,
+                                   const std::vector<glm::vec3>& normals,
+                                   const std::vector<glm::vec2>& texcoords,
+                                   const std::vector<glm::vec3>& colors,
+                                   size_t targetIndexCount, float targetError,
+                                   float* resultError = nullptr);
+
+} // namespace MeshSimplifier
+
+#endif
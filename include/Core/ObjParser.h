@@ -0,0 +1,47 @@
+#ifndef OBJPARSER_H
+#define OBJPARSER_H
+
+#include <string>
+#include <vector>
+
+// 树内 OBJ/MTL 解析器 (替代 TinyObjLoader)
+// 文件 mmap 后按行边界切成若干块，多线程并行解析 v/vt/vn/f，最后合并并三角化
+// 输出与原先 TinyObj 路径一致：多边形自动三角化、每个三角形带材质 ID
+namespace ObjParser {
+
+// 对应 OBJ 的 v/vt/vn 三元组，缺失的分量为 -1 (已转换为从 0 开始的绝对索引)
+struct Index {
+    int vertex;
+    int texcoord;
+    int normal;
+};
+
+struct Material {
+    std::string name;
+    float diffuse[3] = {0.0f, 0.0f, 0.0f}; // Kd (未指定时与 TinyObj 一样默认为 0)
+    std::string diffuseTexname;            // map_Kd
+    std::string specularTexname;           // map_Ks
+};
+
+struct Mesh {
+    std::vector<float> positions; // xyz
+    std::vector<float> normals;   // xyz
+    std::vector<float> texcoords; // uv (未做 Y 翻转)
+
+    std::vector<Index> indices;    // 三角形列表，每 3 个一个三角形
+    std::vector<int> materialIds;  // 每个三角形一个，-1 表示无材质
+
+    std::vector<Material> materials;
+};
+
+// 解析 OBJ 文件，mtlSearchPath 为 mtllib 的查找目录
+// 失败时返回 false 并填写 error；warning 收集非致命问题 (例如找不到材质)
+bool parseFile(const std::string& filename, const std::string& mtlSearchPath,
+               Mesh& mesh, std::string& error, std::string& warning);
+
+// 解析 MTL 文件并追加到 materials
+bool parseMaterialFile(const std::string& filename, std::vector<Material>& materials);
+
+} // namespace ObjParser
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef PROGRAMCACHE_H
+#define PROGRAMCACHE_H
+
+#include "Vendor/glad/glad.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 着色器程序的二进制缓存 (glGetProgramBinary / glProgramBinary)
+// 文件布局: [Header][驱动返回的二进制]，一个程序一个文件，文件名为键的十六进制
+// 驱动不支持程序二进制时所有接口都退化为空操作 (load 总是未命中)
+namespace ProgramCache {
+
+constexpr char MAGIC[4] = {'S', 'P', 'R', 'G'};
+constexpr uint32_t VERSION = 1;
+
+// 缓存目录 (相对于工作目录，和 assets/ 放在一起)
+constexpr const char *DIRECTORY = "shader_cache";
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;          // 再存一次完整的键，防止文件名被改或哈希截断
+    uint32_t binaryFormat; // 驱动给出的格式枚举，原样交回 glProgramBinary
+    uint32_t length;       // 二进制字节数
+};
+
+// 键 = 所有阶段的源码 (含注入的 #define) + 驱动的 vendor/renderer/version
+// 换显卡或者升级驱动后旧的缓存自然失效
+uint64_t makeKey(const std::vector<std::string> &sources);
+
+// 命中时返回已经链接好的程序；未命中或驱动拒绝 (返回 0) 时调用者照常编译
+// 被拒绝的缓存文件会被删除
+GLuint load(uint64_t key);
+
+// 在 glLinkProgram 之前调用：提示驱动保留二进制
+void prepare(GLuint program);
+
+// 链接成功后把二进制写进缓存
+bool store(uint64_t key, GLuint program);
+
+} // namespace ProgramCache
+
+#endif
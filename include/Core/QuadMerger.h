@@ -0,0 +1,26 @@
+#ifndef QUADMERGER_H
+#define QUADMERGER_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// 体素风格模型的共面合并 (Greedy Meshing)
+// 适用于由轴对齐小方块拼成的模型 (例如钻石剑)：整体可以是旋转过的，只要所有面都对齐同一组正交轴
+// 同一平面、同一朝向、同一颜色的相邻矩形会被贪心地合并成尽量大的矩形；
+// 相邻方块之间背靠背重合的内部面会被直接删除 (因此要求模型由封闭的方块组成)
+namespace QuadMerger {
+
+// 输入/输出都是 TriMesh 焊接后的顶点数组 + 三角形索引
+// 合并后的矩形使用新追加的顶点 (法线取对齐轴，UV 为 0)，原来的顶点保留在数组里，
+// 由后续的 MeshOptimizer::optimizeVertexFetch 丢弃
+// 不满足条件的三角形 (非轴对齐、平滑法线、无法拼成完整矩形) 原样保留
+// 返回合并后的三角形是否变少
+bool mergeCoplanarQuads(std::vector<glm::vec3>& positions,
+                        std::vector<glm::vec3>& normals,
+                        std::vector<glm::vec2>& texcoords,
+                        std::vector<glm::vec3>& colors,
+                        std::vector<unsigned int>& indices);
+
+} // namespace QuadMerger
+
+#endif
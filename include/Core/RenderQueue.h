@@ -0,0 +1,83 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include "Vendor/glad/glad.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Core/Shader.h"
+#include "Core/TriMesh.h"
+
+// 主 Pass 的绘制队列：先收集，再按 64 位排序键做基数排序后统一提交
+// 相邻的绘制共用程序 / 材质 / VAO 时跳过重复绑定，不透明物体由近到远，充分利用提前深度测试
+//
+// 排序键 (高位优先):
+//   [63..60] Pass  [59..48] 程序  [47..32] 材质摘要  [31..20] VAO  [19..0] 相机距离
+class RenderQueue {
+public:
+    // 同一个 Pass 内的先后顺序由键的其余部分决定
+    enum Pass : uint8_t {
+        PASS_OPAQUE = 0,     // 不透明
+        PASS_ALPHA_TEST = 1, // alpha test (会关掉提前深度测试，放在不透明物体之后)
+    };
+
+    // 一次绘制
+    struct Packet {
+        const Shader* shader;
+        const TriMesh* mesh;
+        int lod;
+        glm::mat4 model;           // instanceCount == 0 时上传
+        GLuint instanceBuffer;
+        GLsizei firstInstance;
+        GLsizei instanceCount;     // > 0 为实例化绘制 (模型矩阵来自实例缓冲)
+        bool receiveShadows;       // false 时临时关掉 lighting_fs 的 receiveShadows
+    };
+
+    // 上一次 submit 的统计 (绑定次数即实际发生的状态切换)
+    struct Stats {
+        size_t packets = 0;
+        size_t programBinds = 0;
+        size_t materialBinds = 0;
+        size_t vaoBinds = 0;
+    };
+
+    // 每帧开始时调用：清空队列，记录用于计算距离的相机位置
+    // maxDistance: 距离量化的上限 (通常取远平面)，更远的物体按最远处理
+    void begin(const glm::vec3& cameraPos, float maxDistance);
+
+    // 单个物体，距离取模型矩阵的平移
+    void draw(Pass pass, const Shader& shader, const TriMesh& mesh, const glm::mat4& model, int lod = 0);
+    // 实例化批次，distance 由调用者给出 (通常是批次中离相机最近的实例)
+    void drawInstanced(Pass pass, const Shader& shader, const TriMesh& mesh, GLuint instanceBuffer,
+                       GLsizei firstInstance, GLsizei count, int lod, float distance,
+                       bool receiveShadows = true);
+
+    // 排序并按顺序提交，之后队列为空
+    // 返回时不恢复任何状态：VAO、活动纹理单元和程序都保持最后一个绘制包设置的值
+    // 之后要修改 VAO 状态的代码必须先绑定自己的 VAO (见 GLState)
+    void submit();
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    std::vector<Packet> packets;
+    std::vector<uint64_t> keys;
+    // 基数排序的工作区 (跨帧复用，避免每帧分配)
+    std::vector<uint64_t> sortedKeys;
+    std::vector<uint32_t> order, sortedOrder;
+
+    // 程序 -> 12 位编号 (第一次出现时分配，跨帧稳定)
+    std::unordered_map<const Shader*, uint32_t> programIds;
+
+    glm::vec3 cameraPos{0.0f};
+    float maxDistance = 100.0f;
+    Stats stats;
+
+    uint64_t makeKey(Pass pass, const Shader& shader, const TriMesh& mesh, float distance);
+    void push(uint64_t key, const Packet& packet);
+    // 按 keys 对 order 做 LSD 基数排序 (每趟 8 位，所有键在该字节相同时跳过)
+    void radixSort();
+};
+
+#endif
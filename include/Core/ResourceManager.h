@@ -4,8 +4,46 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 #include <iostream>
 #include "Core/TriMesh.h"
+#include "Core/Texture2D.h"
+#include "Core/TextureLoader.h"
+#include "Core/TextureStreamer.h"
+#include "Core/ThreadPool.h"
+
+// 内存报告中的一行 (一个网格)
+struct MeshMemoryReport {
+    std::string path;
+    MeshMemoryStats stats;
+};
+
+// getMeshAsync 返回的句柄：CPU 端的解析在工作线程完成，GL 上传由主线程的 update() 完成后才可用
+class MeshHandle {
+public:
+    MeshHandle() = default;
+
+    bool isValid() const { return state != nullptr; }
+    // GL 上传已经完成
+    bool isReady() const { return state && state->ready; }
+    // 就绪时返回模型，否则返回 nullptr
+    std::shared_ptr<TriMesh> get() const { return isReady() ? state->mesh : nullptr; }
+    const std::string& getPath() const { return state->path; }
+
+private:
+    friend class ResourceManager;
+
+    struct State {
+        std::string path;
+        std::shared_ptr<TriMesh> mesh;
+        std::future<void> cpuJob; // 解析/烘焙 (工作线程)
+        bool ready = false;       // 只在主线程读写
+    };
+
+    explicit MeshHandle(std::shared_ptr<State> state) : state(std::move(state)) {}
+
+    std::shared_ptr<State> state;
+};
 
 class ResourceManager {
 public:
@@ -20,7 +58,42 @@ public:
     void operator=(const ResourceManager&) = delete;
 
     // 获取模型。如果缓存里有，直接返回；如果没有，加载后放入缓存再返回
-    std::shared_ptr<TriMesh> getMesh(const std::string& path);
+    // format / mergeCoplanarQuads 只在首次加载时生效 (同一路径共享同一份 GPU 数据)
+    // mergeCoplanarQuads: 对体素风格的纯色模型做共面合并 (见 QuadMerger)
+    // retention: 上传后 CPU 端保留哪些数据，默认全部释放；需要三角形做物理/拾取时传 Positions
+    std::shared_ptr<TriMesh> getMesh(const std::string& path, VertexFormat format = VertexFormat::Compact,
+                                     bool mergeCoplanarQuads = false,
+                                     MeshRetention retention = MeshRetention::None);
+
+    // 异步获取模型：解析与烘焙交给工作线程，立即返回句柄
+    // 同一路径的并发请求会合并为同一个任务；已经在缓存里的直接返回就绪的句柄
+    MeshHandle getMeshAsync(const std::string& path, VertexFormat format = VertexFormat::Compact,
+                            bool mergeCoplanarQuads = false,
+                            MeshRetention retention = MeshRetention::None);
+    // 阻塞直到句柄就绪 (在主线程调用，会顺带完成该模型的 GL 上传)
+    std::shared_ptr<TriMesh> waitForMesh(const MeshHandle& handle);
+
+    // 获取纹理 (按规范化后的完整路径共享)。缓存只持有弱引用，最后一个使用者释放后纹理随之删除
+    // 加载失败返回 nullptr
+    std::shared_ptr<Texture2D> getTexture(const std::string& path);
+    // 预取：把还没加载的纹理交给解码线程池，之后的 getTexture 只需等待并上传
+    // 一个模型的所有贴图可以并行解码
+    void prefetchTextures(const std::vector<std::string>& paths);
+    // 流式模式：getTexture 立即返回占位纹理，数据由 TextureStreamer 在之后的帧里上传
+    // 启动时的加载保持同步 (首帧就完整)，进入游戏后再打开，用于运行中加载新资源
+    void setTextureStreaming(bool enable);
+    bool isTextureStreaming() const { return streamingEnabled; }
+    // 每帧在主线程调用一次：完成已经解析好的异步模型的 GL 上传，并推进流式纹理上传
+    void update();
+    TextureStreamer& getTextureStreamer() { return streamer; }
+
+    // 1x1 白图：没有漫反射贴图的模型共用这一张 (作为顶点颜色的乘数)
+    std::shared_ptr<Texture2D> getWhiteTexture();
+
+    // 每个已加载网格的 CPU / GPU 占用
+    std::vector<MeshMemoryReport> getMemoryReport() const;
+    // 把内存报告打印到控制台 (含纹理与合计)
+    void printMemoryReport() const;
 
     // 清理所有资源 (在游戏结束时调用，或者智能指针自动释放)
     void clear();
@@ -30,6 +103,21 @@ private:
 
     // 缓存池：路径 -> 模型指针
     std::map<std::string, std::shared_ptr<TriMesh>> meshes;
+    // 正在后台加载的模型 (路径 -> 共享状态)
+    std::map<std::string, std::shared_ptr<MeshHandle::State>> pendingMeshes;
+    // 模型解析线程池 (第一次异步加载时创建)
+    std::unique_ptr<ThreadPool> meshPool;
+
+    // 主线程：上传一个已经解析完的模型并放进缓存
+    void finalizeMesh(const std::shared_ptr<MeshHandle::State>& state);
+
+    // 纹理缓存：规范化路径 -> 纹理 (弱引用，由使用它的网格持有)
+    std::map<std::string, std::weak_ptr<Texture2D>> textures;
+    // 已提交给解码线程池、还没上传的纹理
+    std::map<std::string, std::future<TextureLoader::PreparedImage>> pendingTextures;
+
+    TextureStreamer streamer;
+    bool streamingEnabled = false;
 };
 
 #endif
\ No newline at end of file
@@ -4,10 +4,84 @@
 
 #include <glm/glm.hpp>
 
+#include <cstdint>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/UniformBlocks.h"
+#include "Core/ProgramCache.h"
+#include "Core/GLExtensions.h"
+#include "Core/EmbeddedAssets.h"
+#include "Core/GLState.h"
+
+// uniform 名字的 FNV-1a 哈希，可以在编译期计算
+// seed 用于接着前缀继续哈希 (FNV-1a 是逐字节递推的)
+constexpr uint32_t hashUniformName(const char *name, uint32_t seed = 2166136261u)
+{
+    uint32_t hash = seed;
+    for (; *name; ++name)
+    {
+        hash ^= static_cast<uint8_t>(*name);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// uniform 句柄：只保存名字的哈希
+// 声明成 static constexpr 时哈希在编译期算好，每帧只剩一次查表
+struct UniformId
+{
+    uint32_t hash;
+
+    constexpr UniformId(const char *name) : hash(hashUniformName(name)) {}
+    UniformId(const std::string &name) : hash(hashUniformName(name.c_str())) {}
+
+    // 数组元素 / 结构体数组成员，例如 element("pointLights[", 3, "].position")
+    static constexpr UniformId element(const char *prefix, unsigned index, const char *suffix)
+    {
+        char digits[12] = {};
+        int count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + index % 10);
+            index /= 10;
+        } while (index > 0);
+
+        char reversed[12] = {};
+        for (int i = 0; i < count; ++i)
+            reversed[i] = digits[count - 1 - i];
+
+        return UniformId(hashUniformName(suffix, hashUniformName(reversed, hashUniformName(prefix))));
+    }
+
+private:
+    constexpr explicit UniformId(uint32_t h) : hash(h) {}
+};
+
+// 带值类型的句柄：Shader::set 会在编译期检查类型是否匹配
+template <typename T>
+struct Uniform : UniformId
+{
+    using value_type = T;
+    using UniformId::UniformId;
+    constexpr Uniform(UniformId id) : UniformId(id) {}
+};
+
+// 编译期特性开关，每一项是 "NAME" 或 "NAME=VALUE"，注入为 #define (见 ShaderLibrary)
+using ShaderDefines = std::vector<std::string>;
+
+// Blocking: 构造完即可使用
+// Deferred: 构造函数只提交编译和链接，不查询任何状态；使用前必须 finish()
+//           先把所有程序都提交完再统一 finish，驱动可以在后台并行编译
+enum class ShaderCompileMode
+{
+    Blocking,
+    Deferred
+};
 
 class Shader
 {
@@ -15,129 +89,275 @@ public:
     unsigned int ID;
     // constructor generates the shader on the fly
     // ------------------------------------------------------------------------
-    Shader(const char *vertexPath, const char *fragmentPath)
+    // defines 会插入到两个阶段的 #version 之后
+    Shader(const char *vertexPath, const char *fragmentPath, const ShaderDefines &defines = {},
+           ShaderCompileMode mode = ShaderCompileMode::Blocking)
     {
-        // 1. retrieve the vertex/fragment source code from filePath
+        // 1. retrieve the vertex/fragment source code (编译进程序的嵌入资源优先，没有再读磁盘)
         std::string vertexCode;
         std::string fragmentCode;
-        std::ifstream vShaderFile;
-        std::ifstream fShaderFile;
-        // ensure ifstream objects can throw exceptions:
-        vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        try
-        {
-            // open files
-            vShaderFile.open(vertexPath);
-            fShaderFile.open(fragmentPath);
-            std::stringstream vShaderStream, fShaderStream;
-            // read file's buffer contents into streams
-            vShaderStream << vShaderFile.rdbuf();
-            fShaderStream << fShaderFile.rdbuf();
-            // close file handlers
-            vShaderFile.close();
-            fShaderFile.close();
-            // convert stream into string
-            vertexCode = vShaderStream.str();
-            fragmentCode = fShaderStream.str();
-        }
-        catch (std::ifstream::failure &e)
+        if (!EmbeddedAssets::readText(vertexPath, vertexCode))
+            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << vertexPath << std::endl;
+        if (!EmbeddedAssets::readText(fragmentPath, fragmentCode))
+            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << fragmentPath << std::endl;
+        vertexCode = injectDefines(vertexCode, defines);
+        fragmentCode = injectDefines(fragmentCode, defines);
+        // 2. 先查程序二进制缓存 (键包含注入后的源码，不同变体互不干扰)，命中就跳过编译和链接
+        uint64_t cacheKey = ProgramCache::makeKey({vertexCode, fragmentCode});
+        ID = ProgramCache::load(cacheKey);
+        if (ID == 0)
+            submitProgram(vertexCode, fragmentCode, cacheKey);
+        // 3. 其余工作都要等链接结束，Deferred 模式留给 finish()
+        if (mode == ShaderCompileMode::Blocking || !pending)
+            finish();
+    }
+    // 编译/链接已经结束并完成了初始化，可以 use()
+    bool isReady() const { return ready; }
+    // 非阻塞查询：驱动是否已经编译并链接完 (之后的 finish() 不会等待)
+    // 没有 parallel_shader_compile 扩展时无法得知，返回 false，只能由 finish() 阻塞等待
+    bool isCompileComplete() const
+    {
+        if (!pending)
+            return true;
+        if (!GLExtensions::enableParallelShaderCompile())
+            return false;
+        GLint complete = GL_FALSE;
+        glGetProgramiv(ID, GL_COMPLETION_STATUS_KHR, &complete);
+        return complete != GL_FALSE;
+    }
+    // 等待编译/链接结束：检查错误、写缓存、建立 uniform 表 (重复调用无副作用)
+    void finish()
+    {
+        if (ready)
+            return;
+        if (pending)
         {
-            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
+            pending = false;
+            checkCompileErrors(pendingVertex, "VERTEX");
+            checkCompileErrors(pendingFragment, "FRAGMENT");
+            bool linked = checkCompileErrors(ID, "PROGRAM");
+            // delete the shaders as they're linked into our program now and no longer necessary
+            glDeleteShader(pendingVertex);
+            glDeleteShader(pendingFragment);
+            pendingVertex = pendingFragment = 0;
+
+            if (linked)
+                ProgramCache::store(pendingKey, ID);
         }
-        const char *vShaderCode = vertexCode.c_str();
-        const char *fShaderCode = fragmentCode.c_str();
-        // 2. compile shaders
-        unsigned int vertex, fragment;
-        // vertex shader
-        vertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex, 1, &vShaderCode, NULL);
-        glCompileShader(vertex);
-        checkCompileErrors(vertex, "VERTEX");
-        // fragment Shader
-        fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment, 1, &fShaderCode, NULL);
-        glCompileShader(fragment);
-        checkCompileErrors(fragment, "FRAGMENT");
-        // shader Program
-        ID = glCreateProgram();
-        glAttachShader(ID, vertex);
-        glAttachShader(ID, fragment);
-        glLinkProgram(ID);
-        checkCompileErrors(ID, "PROGRAM");
-        // delete the shaders as they're linked into our program now and no longer necessary
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
+        // 链接后一次性查询所有 active uniform 的位置，之后的 set* 不再访问驱动
+        buildUniformTable();
+        // 共享的 uniform block 接到固定绑定点
+        bindUniformBlocks();
+        ready = true;
     }
     // activate the shader
     // ------------------------------------------------------------------------
     void use() const
     {
-        glUseProgram(ID);
+        GLState::useProgram(ID);
+    }
+    // uniform 位置 (不存在或被编译器优化掉时为 -1，glUniform* 会忽略 -1)
+    GLint getUniformLocation(UniformId name) const
+    {
+        auto it = uniformLocations.find(name.hash);
+        return it != uniformLocations.end() ? it->second : -1;
+    }
+    // 类型检查过的设置接口 (调用前需 use())
+    template <typename T>
+    void set(const Uniform<T> &name, const typename Uniform<T>::value_type &value) const
+    {
+        upload(getUniformLocation(name), value);
     }
     // utility uniform functions
+    // 名字可以是字符串字面量、std::string 或预先算好的 UniformId
     // ------------------------------------------------------------------------
-    void setBool(const std::string &name, bool value) const
+    void setBool(UniformId name, bool value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+        upload(getUniformLocation(name), (int)value);
     }
     // ------------------------------------------------------------------------
-    void setInt(const std::string &name, int value) const
+    void setInt(UniformId name, int value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+        upload(getUniformLocation(name), value);
     }
     // ------------------------------------------------------------------------
-    void setFloat(const std::string &name, float value) const
+    void setFloat(UniformId name, float value) const
     {
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+        upload(getUniformLocation(name), value);
     }
     // ------------------------------------------------------------------------
-    void setVec2(const std::string &name, const glm::vec2 &value) const
+    void setVec2(UniformId name, const glm::vec2 &value) const
     {
-        glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        upload(getUniformLocation(name), value);
     }
-    void setVec2(const std::string &name, float x, float y) const
+    void setVec2(UniformId name, float x, float y) const
     {
-        glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+        glUniform2f(getUniformLocation(name), x, y);
     }
     // ------------------------------------------------------------------------
-    void setVec3(const std::string &name, const glm::vec3 &value) const
+    void setVec3(UniformId name, const glm::vec3 &value) const
     {
-        glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        upload(getUniformLocation(name), value);
     }
-    void setVec3(const std::string &name, float x, float y, float z) const
+    void setVec3(UniformId name, float x, float y, float z) const
     {
-        glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+        glUniform3f(getUniformLocation(name), x, y, z);
     }
     // ------------------------------------------------------------------------
-    void setVec4(const std::string &name, const glm::vec4 &value) const
+    void setVec4(UniformId name, const glm::vec4 &value) const
     {
-        glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        upload(getUniformLocation(name), value);
     }
-    void setVec4(const std::string &name, float x, float y, float z, float w) const
+    void setVec4(UniformId name, float x, float y, float z, float w) const
     {
-        glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+        glUniform4f(getUniformLocation(name), x, y, z, w);
     }
     // ------------------------------------------------------------------------
-    void setMat2(const std::string &name, const glm::mat2 &mat) const
+    void setMat2(UniformId name, const glm::mat2 &mat) const
     {
-        glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        upload(getUniformLocation(name), mat);
     }
     // ------------------------------------------------------------------------
-    void setMat3(const std::string &name, const glm::mat3 &mat) const
+    void setMat3(UniformId name, const glm::mat3 &mat) const
     {
-        glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        upload(getUniformLocation(name), mat);
     }
     // ------------------------------------------------------------------------
-    void setMat4(const std::string &name, const glm::mat4 &mat) const
+    void setMat4(UniformId name, const glm::mat4 &mat) const
     {
-        glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        upload(getUniformLocation(name), mat);
     }
 
 private:
+    // 把 defines 插到 #version 那一行之后 (GLSL 要求 #version 必须在最前面)
+    static std::string injectDefines(const std::string &source, const ShaderDefines &defines)
+    {
+        if (defines.empty())
+            return source;
+
+        std::string block;
+        for (const std::string &define : defines)
+        {
+            size_t eq = define.find('=');
+            if (eq == std::string::npos)
+                block += "#define " + define + "\n";
+            else
+                block += "#define " + define.substr(0, eq) + " " + define.substr(eq + 1) + "\n";
+        }
+
+        size_t version = source.find("#version");
+        if (version == std::string::npos)
+            return block + source;
+        size_t lineEnd = source.find('\n', version);
+        if (lineEnd == std::string::npos)
+            return source + "\n" + block;
+        return source.substr(0, lineEnd + 1) + block + source.substr(lineEnd + 1);
+    }
+
+    // 提交编译和链接，中间不查询任何状态 (查询 GL_COMPILE_STATUS 会迫使驱动同步完成编译)
+    // 有 parallel_shader_compile 扩展时驱动在自己的线程里编译，结果由 finish() 取回
+    void submitProgram(const std::string &vertexCode, const std::string &fragmentCode, uint64_t cacheKey)
+    {
+        GLExtensions::enableParallelShaderCompile();
+
+        const char *vShaderCode = vertexCode.c_str();
+        const char *fShaderCode = fragmentCode.c_str();
+        // vertex shader
+        pendingVertex = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(pendingVertex, 1, &vShaderCode, NULL);
+        glCompileShader(pendingVertex);
+        // fragment Shader
+        pendingFragment = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(pendingFragment, 1, &fShaderCode, NULL);
+        glCompileShader(pendingFragment);
+        // shader Program
+        ID = glCreateProgram();
+        glAttachShader(ID, pendingVertex);
+        glAttachShader(ID, pendingFragment);
+        ProgramCache::prepare(ID);
+        glLinkProgram(ID);
+
+        pendingKey = cacheKey;
+        pending = true;
+    }
+
+    // 已提交、还没 finish 的编译
+    bool ready = false;
+    bool pending = false;
+    GLuint pendingVertex = 0;
+    GLuint pendingFragment = 0;
+    uint64_t pendingKey = 0;
+
+    // 名字哈希 -> uniform 位置
+    std::unordered_map<uint32_t, GLint> uniformLocations;
+
+    static void upload(GLint location, bool value) { glUniform1i(location, (int)value); }
+    static void upload(GLint location, int value) { glUniform1i(location, value); }
+    static void upload(GLint location, float value) { glUniform1f(location, value); }
+    static void upload(GLint location, const glm::vec2 &value) { glUniform2fv(location, 1, &value[0]); }
+    static void upload(GLint location, const glm::vec3 &value) { glUniform3fv(location, 1, &value[0]); }
+    static void upload(GLint location, const glm::vec4 &value) { glUniform4fv(location, 1, &value[0]); }
+    static void upload(GLint location, const glm::mat2 &mat) { glUniformMatrix2fv(location, 1, GL_FALSE, &mat[0][0]); }
+    static void upload(GLint location, const glm::mat3 &mat) { glUniformMatrix3fv(location, 1, GL_FALSE, &mat[0][0]); }
+    static void upload(GLint location, const glm::mat4 &mat) { glUniformMatrix4fv(location, 1, GL_FALSE, &mat[0][0]); }
+
+    // 用 glGetActiveUniform 枚举链接后的所有 uniform
+    // 基本类型数组 (如 foo[4]) 额外登记 "foo" 和每个 "foo[i]"；结构体数组的成员驱动会逐个列出
+    void buildUniformTable()
+    {
+        uniformLocations.clear();
+        GLint count = 0, maxLength = 0;
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+        std::string buffer(maxLength > 0 ? maxLength : 1, '\0');
+
+        for (GLint i = 0; i < count; i++)
+        {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(ID, (GLuint)i, (GLsizei)buffer.size(), &length, &size, &type, &buffer[0]);
+            std::string name(buffer.data(), length);
+
+            GLint location = glGetUniformLocation(ID, name.c_str());
+            if (location < 0)
+                continue; // uniform block 里的成员没有位置
+
+            registerUniform(name, location);
+            if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+            {
+                std::string base = name.substr(0, name.size() - 3);
+                registerUniform(base, location);
+                for (GLint k = 1; k < size; k++)
+                {
+                    std::string element = base + "[" + std::to_string(k) + "]";
+                    registerUniform(element, glGetUniformLocation(ID, element.c_str()));
+                }
+            }
+        }
+    }
+
+    void bindUniformBlocks()
+    {
+        for (const UniformBlockInfo &block : UNIFORM_BLOCKS)
+        {
+            GLuint index = glGetUniformBlockIndex(ID, block.name);
+            if (index != GL_INVALID_INDEX)
+                glUniformBlockBinding(ID, index, block.binding);
+        }
+    }
+
+    void registerUniform(const std::string &name, GLint location)
+    {
+        auto result = uniformLocations.emplace(hashUniformName(name.c_str()), location);
+        if (!result.second && result.first->second != location)
+            std::cout << "WARNING::SHADER::UNIFORM_HASH_COLLISION: " << name << std::endl;
+    }
+
     // utility function for checking shader compilation/linking errors.
     // ------------------------------------------------------------------------
-    void checkCompileErrors(GLuint shader, std::string type)
+    // 返回是否成功
+    bool checkCompileErrors(GLuint shader, std::string type)
     {
         GLint success;
         GLchar infoLog[1024];
@@ -161,6 +381,7 @@ private:
                           << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
             }
         }
+        return success != 0;
     }
 };
 #endif
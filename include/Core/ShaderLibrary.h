@@ -0,0 +1,57 @@
+#ifndef SHADERLIBRARY_H
+#define SHADERLIBRARY_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include "Core/Shader.h"
+
+// 着色器变体库：同一对源文件 + 同一组 #define 只编译一次
+// 材质/Pass 按需要的特性组合出 defines 来取程序，关掉的分支在编译期就被剔除
+//
+// lighting_vs / shadow_depth_vs 支持的特性：
+//   INSTANCED            模型矩阵来自每实例属性 (Layout 4~7) 而不是 uniform
+//
+// lighting_fs 支持的特性：
+//   HAS_SHADOWS          采样阴影贴图 (PCF)
+//   NUM_POINT_LIGHTS=N   点光源个数固定为 N (循环可展开)，不定义时读 UBO 里的 nr_point_lights
+//   ALPHA_TEST           透明像素 discard (关掉后不透明物体可以提前深度测试)
+//   HAS_SPECULAR_MAP     采样独立的高光贴图，否则用漫反射颜色
+//   HAS_SPOT             计算聚光灯
+class ShaderLibrary {
+public:
+    static ShaderLibrary& getInstance() {
+        static ShaderLibrary instance;
+        return instance;
+    }
+
+    ShaderLibrary(const ShaderLibrary&) = delete;
+    void operator=(const ShaderLibrary&) = delete;
+
+    // defines 的顺序不影响结果 (内部排序后作为键)
+    // 返回可以直接使用的程序 (之前 request 过的会在这里等它编译完)
+    std::shared_ptr<Shader> get(const std::string& vertexPath, const std::string& fragmentPath,
+                                const ShaderDefines& defines = {});
+
+    // 只提交编译，不等待结果 (ShaderCompileMode::Deferred)
+    // 启动时先把已知的程序全部 request，驱动可以并行编译，之后再 get / finishAll
+    std::shared_ptr<Shader> request(const std::string& vertexPath, const std::string& fragmentPath,
+                                    const ShaderDefines& defines = {});
+    // 收尾驱动已经编译完的程序 (不阻塞，需要 parallel_shader_compile 扩展)，返回仍在编译的个数
+    size_t poll();
+    // 等待所有已提交的程序
+    void finishAll();
+
+    size_t getProgramCount() const { return programs.size(); }
+
+    // 释放所有程序 (需要在 GL 上下文销毁前调用)
+    void clear() { programs.clear(); }
+
+private:
+    ShaderLibrary() = default;
+
+    // 源文件 + 排序后的 defines -> 程序
+    std::map<std::string, std::shared_ptr<Shader>> programs;
+};
+
+#endif
@@ -4,9 +4,11 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <future>
 #include "Vendor/glad/glad.h"
 #include <glm/glm.hpp>
 #include "Core/Shader.h"
+#include "Core/TextureLoader.h"
 
 class Skybox {
 public:
@@ -17,8 +19,8 @@ public:
     void init();
 
     // 绘制：根据昼夜状态选择贴图
-    // 需要 view 和 projection 矩阵，以及是否是晚上的标志
-    void draw(const glm::mat4& view, const glm::mat4& projection, bool isNight);
+    // view 和 projection 矩阵来自 FrameData UBO，只需要是否是晚上的标志
+    void draw(bool isNight);
 
 private:
     unsigned int dayTextureID;
@@ -27,8 +29,12 @@ private:
     unsigned int VAO, VBO;
     std::shared_ptr<Shader> skyboxShader;
 
-    // 内部工具：加载 Cubemap
-    unsigned int loadCubemap(std::vector<std::string> faces);
+    // 内部工具：把各个面交给解码线程池
+    static std::vector<std::future<TextureLoader::PreparedImage>> prepareFaces(
+        const std::vector<std::string>& faces, const TextureLoader::Options& options);
+    // 内部工具：等待各个面解码完成并上传为 Cubemap
+    unsigned int loadCubemap(const std::vector<std::string>& faces,
+                             std::vector<std::future<TextureLoader::PreparedImage>>& jobs);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef TEXTURE2D_H
+#define TEXTURE2D_H
+
+#include "Vendor/glad/glad.h"
+#include "Core/GLState.h"
+#include <cstddef>
+#include <memory>
+
+// 一张 GL 纹理的所有权 (由 ResourceManager 创建并按路径共享)
+// 最后一个 shared_ptr 释放时删除 GL 对象
+class Texture2D {
+public:
+    Texture2D(GLuint id, int width, int height, size_t byteSize)
+        : id(id), width(width), height(height), byteSize(byteSize) {}
+    ~Texture2D() {
+        if (id) GLState::deleteTextures(1, &id);
+    }
+
+    Texture2D(const Texture2D&) = delete;
+    Texture2D& operator=(const Texture2D&) = delete;
+
+    // 绘制时绑定的纹理：还在流式上传时返回占位纹理 (白图)
+    GLuint getID() const { return resident || !placeholder ? id : placeholder->getID(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    // 估算的显存占用 (含 mipmap)
+    size_t getByteSize() const { return byteSize; }
+    // 是否有透明像素 (决定材质用不用 alpha test 的着色器变体)
+    bool hasAlpha() const { return alpha; }
+    void setHasAlpha(bool value) { alpha = value; }
+
+    // 流式上传 (TextureStreamer) 使用：上传完成之前用 placeholder 代替
+    bool isResident() const { return resident; }
+    void setPlaceholder(std::shared_ptr<Texture2D> texture) {
+        placeholder = std::move(texture);
+        resident = false;
+    }
+    void setResident(int w, int h, size_t bytes) {
+        width = w;
+        height = h;
+        byteSize = bytes;
+        resident = true;
+        placeholder.reset();
+    }
+    GLuint getNativeID() const { return id; }
+
+private:
+    GLuint id;
+    int width, height;
+    size_t byteSize;
+    bool alpha = false;
+
+    bool resident = true;
+    std::shared_ptr<Texture2D> placeholder;
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef TEXTURECOMPRESSOR_H
+#define TEXTURECOMPRESSOR_H
+
+#include <cstdint>
+#include <vector>
+
+// 离线纹理处理：mip 链生成 + BC1/BC3/BC4 块压缩 (纯 CPU，不依赖 GL)
+// 输入统一为 RGBA8，压缩质量以速度优先 (主轴拟合端点)，只在烘焙时运行一次
+namespace TextureCompressor {
+
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> rgba; // width * height * 4
+};
+
+// 生成完整的 mip 链 (2x2 盒式滤波，奇数尺寸时边缘重复)，第 0 级为输入本身
+std::vector<Image> buildMipChain(const Image &base);
+
+// 块压缩整张图片 (尺寸不足 4 的倍数时边缘像素重复填充)
+std::vector<uint8_t> compressBC1(const Image &image);
+std::vector<uint8_t> compressBC3(const Image &image);
+// 只压缩 R 通道
+std::vector<uint8_t> compressBC4(const Image &image);
+
+} // namespace TextureCompressor
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef TEXTUREFILE_H
+#define TEXTUREFILE_H
+
+#include <cstdint>
+#include <string>
+
+// 烘焙纹理格式 (.stex)
+// 布局: [Header][LevelEntry * levelCount][各级 mip 数据]
+// 每一级的数据就是 glTexImage2D / glCompressedTexImage2D 需要的字节，加载时 mmap 后直接上传
+namespace TextureFile {
+
+constexpr char MAGIC[4] = {'S', 'T', 'E', 'X'};
+constexpr uint32_t VERSION = 2;
+
+// 像素格式
+enum class Format : uint32_t {
+    RGBA8 = 0, // 未压缩 (驱动不支持 S3TC 时的回退，以及不适合块压缩的小图)
+    BC1 = 1,   // S3TC DXT1: RGB，每 4x4 块 8 字节
+    BC3 = 2,   // S3TC DXT5: RGBA，每 4x4 块 16 字节
+    BC4 = 3,   // RGTC1: 单通道，每 4x4 块 8 字节 (核心功能)
+};
+
+// Header::flags
+constexpr uint32_t FLAG_HAS_ALPHA = 1u << 0; // 源图片里有不透明度 < 255 的像素 (材质需要 alpha test)
+
+// 各数据块的起始偏移按 16 字节对齐
+constexpr uint64_t BLOCK_ALIGNMENT = 16;
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+
+    uint32_t format;     // Format
+    uint32_t width;      // 第 0 级尺寸
+    uint32_t height;
+    uint32_t levelCount; // mip 级数 (至少为 1)
+    uint32_t channels;   // 源图片的通道数 (1 时采样 .r)
+    uint32_t flags;      // FLAG_*
+};
+
+struct LevelEntry {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;
+    uint64_t size;
+};
+
+inline uint64_t alignOffset(uint64_t offset) {
+    return (offset + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+}
+
+// assets/models/rock/rock.png -> assets/models/rock/rock.stex
+inline std::string getCookedPath(const std::string& sourcePath) {
+    size_t dot = sourcePath.find_last_of('.');
+    size_t slash = sourcePath.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return sourcePath + ".stex";
+    }
+    return sourcePath.substr(0, dot) + ".stex";
+}
+
+} // namespace TextureFile
+
+#endif
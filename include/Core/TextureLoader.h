@@ -0,0 +1,79 @@
+#ifndef TEXTURELOADER_H
+#define TEXTURELOADER_H
+
+#include "Vendor/glad/glad.h"
+#include "Core/MappedFile.h"
+#include "Core/TextureFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+// 纹理加载：优先使用烘焙好的 .stex (预生成 mip 链，可能是块压缩格式)，
+// 没有或过期时用 stb_image 解码源图片，生成 mip 并压缩后写出 .stex 供下次启动使用
+//
+// 分两步：prepare 只做文件读取/解码/压缩 (纯 CPU，可以在工作线程执行)，
+// uploadPrepared 在 GL 线程把准备好的数据上传
+namespace TextureLoader {
+
+struct Options {
+    bool mipmaps = true;      // 是否生成/上传完整 mip 链
+    bool allowCompression = true;
+    // 驱动是否支持 S3TC (GLExtensions 只能在 GL 线程查询，所以由调用者填好)
+    bool s3tcSupported = false;
+    // 立方体贴图的六个面必须是同一种格式：忽略透明度和单通道，只在 BC1 / RGBA8 之间选
+    // (只取决于选项和尺寸，与图片内容无关)
+    bool uniformFormat = false;
+};
+
+// 按当前上下文填好 s3tcSupported 的默认选项 (需在 GL 线程调用)
+Options getDefaultOptions();
+
+struct Info {
+    int width = 0;
+    int height = 0;
+    int levelCount = 0;
+    size_t byteSize = 0; // 上传的总字节数 (所有 mip)
+};
+
+// 准备好等待上传的一张图片
+struct PreparedImage {
+    bool valid = false;
+    std::string sourcePath;
+    TextureFile::Format format = TextureFile::Format::RGBA8;
+    int width = 0;
+    int height = 0;
+    bool hasAlpha = false; // 有透明像素 (见 TextureFile::FLAG_HAS_ALPHA)
+
+    struct Level {
+        int width, height;
+        const unsigned char *data; // 指向 cookedFile 或 ownedData
+        size_t size;
+    };
+    std::vector<Level> levels;
+
+    // 数据来源：烘焙文件的映射，或者刚压缩出来的内存
+    MappedFile cookedFile;
+    std::vector<std::vector<uint8_t>> ownedData;
+};
+
+// 读取/解码一张图片 (可在任意线程调用)
+PreparedImage prepare(const std::string &sourcePath, const Options &options);
+// 在解码线程池中执行 prepare
+std::future<PreparedImage> prepareAsync(const std::string &sourcePath, const Options &options);
+
+// 把准备好的数据上传到当前绑定纹理的 target
+// (GL_TEXTURE_2D 或 GL_TEXTURE_CUBE_MAP_POSITIVE_X + i)，失败返回 false
+bool uploadPrepared(const PreparedImage &image, GLenum target, Info &info);
+
+// 上传单个 mip 级别 (data 可以是内存指针，也可以是绑定了 PIXEL_UNPACK_BUFFER 时的偏移)
+void uploadLevel(GLenum target, int level, TextureFile::Format format, int width, int height,
+                 const void *data, size_t size);
+
+// prepare + uploadPrepared 的同步版本
+bool upload(const std::string &sourcePath, GLenum target, const Options &options, Info &info);
+
+} // namespace TextureLoader
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef TEXTURESTREAMER_H
+#define TEXTURESTREAMER_H
+
+#include "Vendor/glad/glad.h"
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "Core/Texture2D.h"
+#include "Core/TextureLoader.h"
+
+// 游戏过程中的纹理流式上传
+// 解码在 TextureLoader 的线程池中完成；GL 线程每帧调用 update，
+// 把准备好的 mip 级别经由 PBO 环形缓冲上传，并受每帧字节数/耗时预算限制。
+// 上传完成 (fence 通过) 之前，Texture2D 返回占位白图
+class TextureStreamer {
+public:
+    // 每帧预算
+    struct Budget {
+        size_t maxBytes = 4 * 1024 * 1024;
+        double maxMilliseconds = 2.0;
+    };
+
+    TextureStreamer() = default;
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    // 把 texture (已创建 GL 对象，尚未上传数据) 加入队列；image 为 TextureLoader::prepareAsync 的结果
+    void enqueue(std::shared_ptr<Texture2D> texture, std::future<TextureLoader::PreparedImage> image);
+
+    // 每帧调用一次 (GL 线程)
+    void update();
+
+    // 阻塞直到所有任务完成 (退出或切换场景前使用)
+    void flush();
+
+    bool isIdle() const { return jobs.empty(); }
+    size_t getPendingCount() const { return jobs.size(); }
+
+    void setBudget(const Budget& value) { budget = value; }
+    const Budget& getBudget() const { return budget; }
+
+private:
+    struct Job {
+        std::shared_ptr<Texture2D> texture;
+        std::future<TextureLoader::PreparedImage> future;
+        TextureLoader::PreparedImage image;
+        bool prepared = false;
+        size_t nextLevel = 0;
+        size_t uploadedBytes = 0;
+        GLsync fence = nullptr; // 最后一级上传后插入
+    };
+
+    // 环形缓冲中的一个 PBO
+    struct Slot {
+        GLuint pbo = 0;
+        size_t capacity = 0;
+        GLsync fence = nullptr; // 使用该 PBO 的上传命令完成后才能再次写入
+    };
+
+    static const int SLOT_COUNT = 4;
+
+    // 取得下一个空闲的 PBO (GPU 还在读取时返回 nullptr)
+    Slot* acquireSlot(size_t size);
+    // 上传一个 mip 级别，返回是否成功
+    bool uploadLevel(Job& job);
+    // 检查 fence，完成的任务标记为驻留
+    void retireFinished();
+
+    std::deque<Job> jobs;
+    Slot slots[SLOT_COUNT];
+    int nextSlot = 0;
+    Budget budget;
+};
+
+#endif
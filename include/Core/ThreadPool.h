@@ -0,0 +1,55 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// 固定数量的工作线程 + FIFO 任务队列
+// 只做纯 CPU 的工作 (解码、压缩、解析)，任何 GL 调用都必须回到主线程
+class ThreadPool {
+public:
+    // threadCount = 0 时使用 hardware_concurrency
+    explicit ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 提交任务，返回的 future 在任务完成后就绪 (任务抛出的异常也会传递给 future)
+    template <typename F>
+    auto submit(F&& task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+        // packaged_task 不可拷贝，包一层 shared_ptr 放进 std::function
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        condition.notify_one();
+        return future;
+    }
+
+    size_t getThreadCount() const { return workers.size(); }
+
+    // 当前线程是否是某个 ThreadPool 的工作线程
+    // 池里的任务不应该再自己开一批线程 (池已经占满了所有核心)
+    static bool isWorkerThread();
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+};
+
+#endif
@@ -10,19 +10,46 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
+
+#include "Core/VertexFormat.h"
+#include "Core/Texture2D.h"
+#include "Core/MappedFile.h"
+#include "Core/Shader.h"
 
 // --- 移除 Assimp ---
 // #include <assimp/Importer.hpp>
 // #include <assimp/scene.h>
 // #include <assimp/postprocess.h>
 
-// --- 添加 TinyObjLoader ---
+// --- 移除 TinyObjLoader，改用自带的多线程 ObjParser ---
 
 
 struct Texture {
 	unsigned int id;
 	std::string type;
 	std::string path;
+	// GL 纹理由 ResourceManager 按路径共享，这里只持有一份引用
+	std::shared_ptr<Texture2D> resource;
+};
+
+// 一个 LOD 级别：同一个 EBO 中的一段索引 (所有级别共用同一个 VBO)
+struct MeshLod {
+	GLsizei indexOffset; // 起始索引 (以索引个数计)
+	GLsizei indexCount;
+	float error;         // 相对于包围盒对角线的几何误差，LOD 0 为 0
+};
+
+// 上传到 GPU 之后 CPU 端保留哪些数据
+enum class MeshRetention {
+	None,      // 全部释放 (默认，只靠 GPU 数据绘制)
+	Positions, // 保留一份紧凑的 位置 + LOD 0 索引，给物理/拾取用
+};
+
+// 单个网格占用的内存 (字节)
+struct MeshMemoryStats {
+	size_t cpuBytes; // 仍然驻留在内存中的数组 (按 capacity 计)
+	size_t gpuBytes; // VBO + EBO (贴图单独统计)
 };
 
 typedef struct vIndex {
@@ -38,13 +65,74 @@ public:
 	// 支持自动加载贴图 + 自动烘焙材质颜色
 	void readObjTiny(const std::string &filename);
 
+	// 烘焙格式 (.smesh)：mmap 后直接上传，不做任何解析
+	// 加载失败 (文件不存在/版本不符/数据损坏) 返回 false，调用者应回退到 readObjTiny
+	bool loadCooked(const std::string &filename);
+	// 把当前的 GPU 数据写成烘焙格式，供下次启动使用
+	bool saveCooked(const std::string &filename) const;
+
+	// 异步加载用的两阶段接口 (readObjTiny / loadCooked = 第一阶段 + uploadToGpu)
+	// 第一阶段只做 CPU 工作，可以在工作线程执行；saveCooked 也可以在第一阶段之后直接调用
+	bool parseObj(const std::string &filename);
+	bool mapCooked(const std::string &filename);
+	// 第二阶段：必须在 GL 线程调用，加载贴图并上传 VBO/EBO
+	void uploadToGpu();
+	bool isUploaded() const { return vao != 0; }
+	// 该模型引用的贴图 (完整路径，不含白图)，用于提前交给解码线程池
+	std::vector<std::string> getTexturePaths() const;
+
 	// 新增一个只画几何体的方法，用于阴影 Pass 或者自定义 Shader
-	void drawGeometry(GLuint program, const glm::mat4 &model);
+	// lod: LOD 级别 (0 为原始精度，超出范围时取最粗的一级)
+	void drawGeometry(const Shader &shader, const glm::mat4 &model, int lod = 0);
 	// 简化原有的 draw
-	void draw(GLuint program, const glm::mat4 &model);
+	void draw(const Shader &shader, const glm::mat4 &model, int lod = 0);
+	// 实例化绘制：模型矩阵取自 instanceBuffer 中从 firstInstance 开始的 count 个 mat4 (Layout 4~7)
+	// 着色器需要是 INSTANCED 变体；贴图和材质只绑定一次
+	void drawInstanced(const Shader &shader, GLuint instanceBuffer, GLsizei firstInstance, GLsizei count, int lod = 0);
+	void drawGeometryInstanced(GLuint instanceBuffer, GLsizei firstInstance, GLsizei count, int lod = 0);
+
+	// 给 RenderQueue 用的底层接口：状态由调用者负责绑定，跨绘制复用时可以跳过
+	// 绑定贴图、设置采样器编号和高光系数
+	void bindMaterial(const Shader &shader) const;
+	// 两个网格的贴图和高光系数完全相同 (可以共用一次 bindMaterial)
+	bool sharesMaterial(const TriMesh &other) const;
+	// 材质的 16 位摘要，只用于排序 (相同材质一定相同，不同材质偶尔碰撞)
+	uint16_t getMaterialKey() const;
+	GLuint getVertexArray() const { return vao; }
+	// 把实例缓冲接到本网格 VAO 的 Layout 4~7 (调用前需绑定 VAO)
+	// GL 3.3 没有 baseInstance，起始实例用属性偏移表示
+	void bindInstanceAttributes(GLuint instanceBuffer, GLsizei firstInstance) const;
+	// 画指定 LOD (调用前需绑定 VAO)，instanceCount > 0 时为实例化绘制
+	void drawLod(int lod, GLsizei instanceCount = 0) const;
 	void storeFacesPoints();
+
+	// 顶点格式 (默认 Compact)，需要在加载前设置
+	void setVertexFormat(VertexFormat format) { vertexFormat = format; }
+	VertexFormat getVertexFormat() const { return vertexFormat; }
+	// 体素模型的共面合并 (默认关闭)，需要在加载前设置
+	void setMergeCoplanarQuads(bool enable) { mergeCoplanar = enable; }
+	bool getMergeCoplanarQuads() const { return mergeCoplanar; }
+	// CPU 端数据的保留策略 (默认 None)，需要在加载前设置
+	void setRetention(MeshRetention policy) { retention = policy; }
+	MeshRetention getRetention() const { return retention; }
 	void cleanData();
 
+	// 上传 (以及烘焙) 完成后调用：按保留策略释放 CPU 端的顶点/索引副本
+	void releaseCpuData();
+	// MeshRetention::Positions 时保留的数据，否则为空
+	const std::vector<glm::vec3> &getRetainedPositions() const { return retainedPositions; }
+	const std::vector<unsigned int> &getRetainedIndices() const { return retainedIndices; }
+
+	MeshMemoryStats getMemoryStats() const;
+
+	// 材质特性 (上传后有效)，用来选择着色器变体
+	// 漫反射贴图有透明像素 -> 需要 alpha test
+	bool hasAlphaTexture() const;
+	// 有独立的高光贴图 (没有时着色器用漫反射颜色代替)
+	bool hasSpecularMap() const;
+	// 还有贴图在流式上传 (此时绘制用的是占位白图)
+	bool hasPendingTextures() const;
+
 	// Setter
 	void setAmbient(glm::vec4 a) { ambient = a; }
 	void setDiffuse(glm::vec4 d) { diffuse = d; }
@@ -55,6 +143,10 @@ public:
 	glm::vec3 getMinBound() const { return minBound; }
 	glm::vec3 getMaxBound() const { return maxBound; }
 	glm::vec3 getSize() const { return maxBound - minBound; } // 原始长宽高
+
+	// LOD 级别数 (至少为 1)
+	int getLodCount() const { return lods.empty() ? 1 : static_cast<int>(lods.size()); }
+	const MeshLod &getLod(int lod) const { return lods[clampLod(lod)]; }
 protected:
 	// 原始数据
 	std::vector<glm::vec3> vertex_positions;
@@ -62,21 +154,54 @@ protected:
 	std::vector<glm::vec3> vertex_normals;
 	std::vector<glm::vec2> vertex_texcoords;
 
+	// 三角形索引 (指向焊接后的 vertex_* 数组)
 	std::vector<vec3i> faces;
 
-	// GPU 数据
-	std::vector<glm::vec3> points;
-	std::vector<glm::vec3> colors;          // 传给 layout=3
-	std::vector<glm::vec3> normals;
-	std::vector<glm::vec2> texcoords;
-
 	std::vector<Texture> textures;
 	glm::vec4 ambient, diffuse, specular;
 	float shininess;
 
-	GLuint vao, vbo;
-
-	static unsigned int loadTexture(const std::string &path, const std::string &directory);
+	GLuint vao, vbo, ebo;
+	GLsizei vertexCount; // 唯一顶点数 (烘焙加载时没有 vertex_* 数组)
+	GLsizei indexCount;  // EBO 中的索引总数 (含所有 LOD)
+	GLenum indexType;    // GL_UNSIGNED_SHORT / GL_UNSIGNED_INT
+	VertexFormat vertexFormat; // VBO 中交错顶点的编码方式
+	bool mergeCoplanar;        // 加载时是否做共面合并
+	MeshRetention retention;   // 上传后 CPU 端保留哪些数据
+
+	// 模型所在目录 (贴图路径相对于它)
+	std::string sourceDirectory;
+	// mapCooked 之后、uploadToGpu 之前保留的烘焙文件映射
+	MappedFile cookedFile;
+	const unsigned char *cookedVertexData = nullptr;
+	const unsigned char *cookedIndexData = nullptr;
+	uint64_t cookedVertexBytes = 0;
+	uint64_t cookedIndexBytes = 0;
+
+	// releaseCpuData 之后留下的紧凑副本 (只有 LOD 0)
+	std::vector<glm::vec3> retainedPositions;
+	std::vector<unsigned int> retainedIndices;
+
+	// LOD 0 之后的简化级别，索引依次接在 faces 后面一起放进 EBO
+	std::vector<unsigned int> lodIndices;
+	std::vector<MeshLod> lods;
+
+	// 用 QuadMerger 合并共面的轴对齐矩形 (在 optimizeMesh 之前调用)
+	void mergeCoplanarFaces(const std::string &name);
+	// 顶点缓存 / 过度绘制 / 顶点读取顺序优化，并打印优化前后的 ACMR
+	void optimizeMesh(const std::string &name);
+	// 用 MeshSimplifier 逐级生成简化 LOD (需在 optimizeMesh 之后调用)
+	void generateLods(const std::string &name);
+	int clampLod(int lod) const;
+
+	// 烘焙加载时直接从文件的顶点/索引块里取出需要保留的位置和 LOD 0 索引
+	void retainFromCooked(const unsigned char *vertexBytes, const unsigned char *indexBytes, size_t indexSize);
+
+	// 按索引类型把 faces + lodIndices 打包成 EBO 字节
+	std::vector<unsigned char> buildIndexData(GLenum type) const;
+
+	// 从 ResourceManager 的纹理缓存取得贴图 ("internal_white" 为共享的白图)
+	static Texture acquireTexture(const std::string &path, const std::string &directory, const std::string &type);
 
 	// 存储原始边界
 	glm::vec3 minBound;
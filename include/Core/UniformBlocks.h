@@ -0,0 +1,66 @@
+#ifndef UNIFORMBLOCKS_H
+#define UNIFORMBLOCKS_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+
+// 所有着色器共用的 uniform block (std140 布局)
+// 这里的结构体必须和 GLSL 里的声明逐字节对应，修改时两边一起改
+// GLSL 3.3 不支持 layout(binding = N)，由 Shader 链接后按名字调用 glUniformBlockBinding
+
+// 固定绑定点
+enum UniformBlockBinding {
+    FRAME_DATA_BINDING = 0,
+    LIGHT_DATA_BINDING = 1,
+};
+
+struct UniformBlockInfo {
+    const char* name;
+    UniformBlockBinding binding;
+};
+
+constexpr UniformBlockInfo UNIFORM_BLOCKS[] = {
+    {"FrameData", FRAME_DATA_BINDING},
+    {"LightData", LIGHT_DATA_BINDING},
+};
+
+// 每帧更新一次：相机与阴影矩阵
+struct FrameData {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 lightSpaceMatrix;
+    glm::vec4 viewPos; // xyz 有效
+};
+
+// std140 下 vec3 按 16 字节对齐，后面正好塞一个 float
+struct DirLightStd140 {
+    glm::vec3 direction; float pad0;
+    glm::vec3 ambient;   float pad1;
+    glm::vec3 diffuse;   float pad2;
+    glm::vec3 specular;  float pad3;
+};
+
+struct PointLightStd140 {
+    glm::vec3 position; float constant;
+    glm::vec3 ambient;  float linear;
+    glm::vec3 diffuse;  float quadratic;
+    glm::vec3 specular; float pad0;
+};
+
+// 与着色器里的 NR_POINT_LIGHTS 一致
+constexpr int MAX_UBO_POINT_LIGHTS = 16;
+
+// 光照数据：只在灯光变化时更新
+struct LightData {
+    DirLightStd140 dirLight;
+    PointLightStd140 pointLights[MAX_UBO_POINT_LIGHTS];
+    int nrPointLights; int pad[3];
+};
+
+static_assert(sizeof(FrameData) == 208, "FrameData must match the std140 layout");
+static_assert(sizeof(DirLightStd140) == 64, "DirLight must match the std140 layout");
+static_assert(sizeof(PointLightStd140) == 64, "PointLight must match the std140 layout");
+static_assert(offsetof(LightData, nrPointLights) == 64 + 64 * MAX_UBO_POINT_LIGHTS,
+              "LightData must match the std140 layout");
+
+#endif
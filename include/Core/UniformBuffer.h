@@ -0,0 +1,42 @@
+#ifndef UNIFORMBUFFER_H
+#define UNIFORMBUFFER_H
+
+#include "Vendor/glad/glad.h"
+#include <cstddef>
+
+// 一个绑定在固定绑定点上的 UBO
+// GL 对象在第一次 update 时才创建 (构造时可能还没有 GL 上下文)
+class UniformBuffer {
+public:
+    UniformBuffer(GLuint binding, size_t size) : binding(binding), size(size) {}
+    ~UniformBuffer() {
+        if (id) glDeleteBuffers(1, &id);
+    }
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    // 整块更新：先孤立旧存储 (驱动可能还在用上一帧的数据)，再写入
+    void update(const void* data) {
+        if (!id) {
+            glGenBuffers(1, &id);
+            glBindBuffer(GL_UNIFORM_BUFFER, id);
+            glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+            glBindBufferBase(GL_UNIFORM_BUFFER, binding, id);
+        } else {
+            glBindBuffer(GL_UNIFORM_BUFFER, id);
+            glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        }
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    GLuint getBinding() const { return binding; }
+
+private:
+    GLuint id = 0;
+    GLuint binding;
+    size_t size;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef VERTEXFORMAT_H
+#define VERTEXFORMAT_H
+
+#include "Vendor/glad/glad.h"
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// 交错顶点格式 (每个顶点的所有属性连续存放)，Shader 端 Layout 0~3 保持不变:
+//   0: Position  1: Normal  2: TexCoord  3: Color
+enum class VertexFormat : uint32_t {
+    // 全精度: vec3 + vec3 + vec2 + vec3 = 44 字节
+    Float = 0,
+    // 压缩: vec3 位置 + INT_2_10_10_10_REV 法线 + half2 UV + RGBA8 颜色 = 24 字节
+    Compact = 1,
+};
+
+#pragma pack(push, 1)
+struct FloatVertex {
+    float position[3];
+    float normal[3];
+    float texcoord[2];
+    float color[3];
+};
+
+struct CompactVertex {
+    float position[3];
+    uint32_t normal;      // 10:10:10:2 有符号归一化
+    uint16_t texcoord[2]; // IEEE half (UV 可能超出 [0,1]，所以不用归一化整数)
+    uint8_t color[4];     // RGBA8 归一化
+};
+#pragma pack(pop)
+
+static_assert(sizeof(FloatVertex) == 44, "FloatVertex must be tightly packed");
+static_assert(sizeof(CompactVertex) == 24, "CompactVertex must be tightly packed");
+
+namespace VertexLayout {
+
+// 每个顶点占用的字节数
+GLsizei getStride(VertexFormat format);
+
+// 把平面数组打包成交错的顶点字节流 (四个数组长度必须一致)
+std::vector<unsigned char> pack(VertexFormat format,
+                                const std::vector<glm::vec3>& positions,
+                                const std::vector<glm::vec3>& normals,
+                                const std::vector<glm::vec2>& texcoords,
+                                const std::vector<glm::vec3>& colors);
+
+// 为当前绑定的 VAO/VBO 配置 Layout 0~3
+void setupAttributes(VertexFormat format);
+
+// 编码工具
+uint16_t floatToHalf(float value);
+uint32_t packNormal(const glm::vec3& normal);
+
+} // namespace VertexLayout
+
+#endif
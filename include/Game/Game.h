@@ -9,6 +9,8 @@
 // 子系统
 #include "Core/Shader.h"
 #include "Core/Camera.h"
+#include "Core/UniformBuffer.h"
+#include "Core/RenderQueue.h"
 #include "Game/Steve.h"
 #include "Game/Scene.h"
 #include "Game/LightManager.h"
@@ -49,7 +51,8 @@ public:
 private:
     GLFWwindow* window;
 
-    std::shared_ptr<Shader> lightingShader;
+    // 主光照着色器的变体：不透明 / alpha test，各自再分单个物体 / 实例化 (都来自 ShaderLibrary)
+    LightingShaders lightingShaders;
     std::shared_ptr<Camera> camera;
     std::shared_ptr<Steve> steve;
     std::shared_ptr<Steve> alex;
@@ -62,6 +65,13 @@ private:
     std::unique_ptr<UIManager> uiManager;
 
     std::shared_ptr<Shader> depthShader;
+    std::shared_ptr<Shader> instancedDepthShader; // 静态物体的实例化阴影
+
+    // 主 Pass 的绘制队列 (角色和场景先收集，排序后统一提交)
+    RenderQueue renderQueue;
+
+    // 每帧的相机/阴影矩阵 (FrameData UBO，所有着色器共享)
+    UniformBuffer frameBuffer{FRAME_DATA_BINDING, sizeof(FrameData)};
 
     std::vector<AABB> staticObstacles;
     bool pressB;
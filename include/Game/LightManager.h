@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include "Core/Shader.h"
+#include "Core/UniformBuffer.h"
 
 // 对应 Shader 中的 DirLight
 struct DirLight
@@ -53,8 +54,9 @@ public:
     // 初始化：设置默认的灯光位置
     void init();
 
-    // 核心功能：将光照数据传给 Shader
-    void apply(Shader &shader);
+    // 核心功能：将光照数据写进所有着色器共享的 LightData UBO
+    // 每帧调用一次，只有灯光变化过才真正上传
+    void upload();
 
     // 切换白天/黑夜
     void toggleDayNight();
@@ -115,6 +117,10 @@ private:
     // 存储当前太阳和月亮的状态
     CelestialConfig sunConfig;
     CelestialConfig moonConfig;
+
+    // 光照 UBO (绑定点 LIGHT_DATA_BINDING)，修改灯光的接口都会把 dirty 置位
+    UniformBuffer lightBuffer{LIGHT_DATA_BINDING, sizeof(LightData)};
+    bool dirty = true;
 };
 
 #endif
\ No newline at end of file
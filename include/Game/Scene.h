@@ -4,11 +4,16 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <map>
 #include <glm/glm.hpp>
 
 #include "Core/TriMesh.h"
 #include "Core/Shader.h"
 #include "Core/AABB.h"
+#include "Core/Frustum.h"
+#include "Core/Impostor.h"
+#include "Core/InstanceBuffer.h"
+#include "Core/RenderQueue.h"
 
 // 前向声明
 class LightManager;
@@ -18,6 +23,38 @@ class Skybox;
 struct SceneObject {
     std::shared_ptr<TriMesh> mesh;
     glm::mat4 modelMatrix; // 预计算好的渲染矩阵
+
+    // LOD 选择用的世界空间包围球
+    glm::vec3 worldCenter;
+    float boundingRadius;
+    // 视锥剔除用的世界空间包围盒，visible 由每帧的 cull() 更新
+    AABB worldBounds;
+    bool visible = true;
+    int lod = 0; // 当前使用的 LOD (带迟滞，每帧在主 Pass 中更新)
+
+    // 是否画进阴影贴图 / 是否接收方向光阴影 (addStaticObject 时决定)
+    bool castsShadows = true;
+    bool receivesShadows = true;
+
+    // 远景替身 (只有 addStaticObject 时允许的物体才有)
+    std::shared_ptr<Impostor> impostor;
+    bool usingImpostor = false;
+};
+
+// 主光照着色器的一组变体 (都来自 ShaderLibrary)
+struct LightingShaders {
+    std::shared_ptr<Shader> opaque;             // 单个物体 (地面、天体、角色)
+    std::shared_ptr<Shader> alphaTest;          // + ALPHA_TEST
+    std::shared_ptr<Shader> instanced;          // + INSTANCED，静态物体批量绘制
+    std::shared_ptr<Shader> instancedAlphaTest; // + INSTANCED + ALPHA_TEST
+};
+
+// 共用同一个网格的静态物体 (加载地图时分组)
+// 每帧按 LOD 拆成若干段，每段一次实例化绘制
+struct InstanceGroup {
+    std::shared_ptr<TriMesh> mesh;
+    bool receivesShadows = true; // 同一网格接收与不接收阴影的物体分在两组
+    std::vector<size_t> objects; // renderQueue 下标
 };
 
 class Scene {
@@ -27,25 +64,75 @@ public:
 
     void init();
 
-    // 加载地图 (目前接收 LightManager 是为了放置路灯)
-    void loadMap(const std::shared_ptr<LightManager>& lightManager);
+    // 放置地图的点光源 (只写 LightManager，不加载任何资源)
+    // 主光照着色器按点光源个数编译，先调用它就能在加载模型之前提交编译
+    void loadLights(const std::shared_ptr<LightManager>& lightManager);
+    // 加载地图 (生成物体和碰撞盒)
+    void loadMap();
 
     // 获取计算好的碰撞盒 (给 Game 类用于物理检测)
     const std::vector<AABB>& getObstacles() const { return collisionBoxes; }
 
-    // 渲染
-    void draw(Shader& shader, const glm::mat4& view, const glm::mat4& projection, LightManager* lights);
+    // 视锥剔除：在 draw 之前调用，之后的主 Pass 跳过不可见的地面和静态物体
+    // 阴影 Pass 不受影响 (视野外的物体仍然可能把影子投进画面)
+    void cull(const Frustum& frustum);
+
+    // 渲染：地面和静态物体的实例化批次放进绘制队列 (贴图带透明的用 ALPHA_TEST 变体)
+    // 同时选好每个物体的 LOD 和替身，供 drawFarField 使用
+    void draw(RenderQueue& queue, const LightingShaders& shaders, const glm::mat4& view, const glm::mat4& projection);
+    // 队列提交之后直接绘制的远景：天体、替身面片、天空盒 (画在近处物体之后，大部分像素被深度测试挡掉)
+    // 返回时 shader 处于激活状态
+    void drawFarField(Shader& shader, const glm::mat4& view, LightManager* lights);
+
+    // instancedShader: 深度着色器的 INSTANCED 变体；调用时 shader 处于激活状态，返回时也是
+    // 只画投射阴影的物体，并按光源视锥 (朝光源方向延伸) 剔除
+    void drawShadow(Shader& shader, Shader& instancedShader, const glm::mat4& lightSpaceMatrix);
 
-    void drawShadow(Shader& shader);
+    // 超过该距离 (相机到包围球中心) 的树木和天体改画替身面片
+    void setImpostorDistance(float distance) { impostorDistance = distance; }
+    float getImpostorDistance() const { return impostorDistance; }
 private:
     std::shared_ptr<TriMesh> ground;
     std::shared_ptr<TriMesh> sunMesh;
     std::shared_ptr<TriMesh> moonMesh;
     std::shared_ptr<Skybox> skybox;
 
+    // 替身：烘焙用 / 绘制用着色器，以及按网格共享的替身缓存
+    std::shared_ptr<Shader> impostorBakeShader;
+    std::shared_ptr<Shader> impostorShader;
+    std::map<const TriMesh*, std::shared_ptr<Impostor>> impostors;
+    std::shared_ptr<Impostor> sunImpostor;
+    std::shared_ptr<Impostor> moonImpostor;
+    // 天体当前是否在画替身 (和 SceneObject::usingImpostor 一样用于迟滞)
+    bool sunUsingImpostor = false;
+    bool moonUsingImpostor = false;
+    float impostorDistance;
+
     // 统一管理所有的静态场景物体 (路灯、树等)
     std::vector<SceneObject> renderQueue;
 
+    // 与 renderQueue 一一对应的包围盒 (SoA，批量剔除用) 和剔除结果
+    BoundsList objectBounds;
+    std::vector<uint8_t> objectVisibility;
+    std::vector<uint8_t> shadowVisibility; // 光源视锥的剔除结果
+    AABB groundBounds;
+    bool groundVisible = true;
+
+    // 按网格分组的静态物体，以及每个 Pass 临时拼出来的实例矩阵
+    struct InstanceBatch {
+        const InstanceGroup* group;
+        int lod;
+        GLsizei firstInstance;
+        GLsizei count;
+        float nearestDistance; // 离相机最近的实例 (包围球表面)，用于队列的由近到远排序
+    };
+    std::vector<InstanceGroup> instanceGroups;
+    std::vector<glm::mat4> instanceMatrices;
+    std::vector<InstanceBatch> instanceBatches;
+    InstanceBuffer instanceBuffer;
+    // 本帧改画替身的物体 (draw 中选出，drawFarField 绘制)
+    std::vector<const SceneObject*> impostorObjects;
+
     // 统一存储所有的碰撞盒
     std::vector<AABB> collisionBoxes;
 
@@ -54,10 +141,31 @@ private:
     // pos: 世界坐标位置 (x, y, z)
     // scale: 缩放倍数
     // colliderWidth: 碰撞柱半径，如果 < 0 则不生成碰撞盒
-    void addStaticObject(const std::string& path, glm::vec3 pos, float scale, float colliderWidth = -1.0f);
+    // allowImpostor: 远处是否可以用替身面片代替 (适合树木这类轮廓复杂、远看差别不大的物体)
+    // castsShadows: 是否投射阴影 (太小的物体即使为 true 也不投射，见 MIN_SHADOW_CASTER_SIZE)
+    // receivesShadows: 是否接收阴影 (自己发光的物体，例如篝火，不需要)
+    void addStaticObject(const std::string& path, glm::vec3 pos, float scale, float colliderWidth = -1.0f,
+                         bool allowImpostor = false, bool castsShadows = true, bool receivesShadows = true);
+
+    // 加载地图后把 renderQueue 按网格分组
+    void buildInstanceGroups();
+    // 把每组物体按 LOD 排好写进 instanceBuffer，结果在 instanceBatches
+    // mainPass: 只收集可见、且没有改画替身的物体；否则收集光源视锥内投射阴影的物体
+    // cameraPos 只在主 Pass 用于计算批次距离
+    void prepareInstanceBatches(bool mainPass, const glm::vec3& cameraPos = glm::vec3(0.0f));
+
+    // 取得 (必要时烘焙) 某个网格的替身，烘焙失败返回 nullptr
+    std::shared_ptr<Impostor> getImpostor(const std::shared_ptr<TriMesh>& mesh);
+    // 带迟滞的距离判断，避免在阈值附近来回切换
+    bool shouldUseImpostor(bool current, float distance) const;
+
+    // 根据包围球在屏幕上的投影大小挑选 LOD (带迟滞，避免在阈值附近来回跳)
+    // screenSize: 包围球直径占视口高度的比例
+    static int selectLod(int currentLod, int lodCount, float screenSize);
 
     // 辅助绘制天体
-    void drawCelestialBody(std::shared_ptr<TriMesh> mesh, Shader& shader,LightManager* lights, bool isSun);
+    void drawCelestialBody(std::shared_ptr<TriMesh> mesh, Shader& shader,LightManager* lights, bool isSun,
+                           const glm::vec3& cameraPos);
 
 };
 
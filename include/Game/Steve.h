@@ -13,6 +13,7 @@
 #include "Core/AABB.h"
 #include "Core/TriMesh.h"
 #include "Core/Shader.h"
+#include "Core/RenderQueue.h"
 
 enum class SteveState {
     IDLE,       // 站立 (只呼吸，不摆臂)
@@ -41,7 +42,8 @@ public:
     // 这样无论是玩家控制还是AI控制，只需要构造这个结构体传进去即可
     void update(float dt, const SteveInput& input, const std::vector<AABB>& obstacles,AABB otherPlayerBox);
 
-    void draw(Shader& shader);
+    // 各部件放进绘制队列：贴图有透明像素的部件用 alphaTestShader (ALPHA_TEST 变体)，其余用 opaqueShader
+    void draw(RenderQueue& queue, const Shader& opaqueShader, const Shader& alphaTestShader);
     void drawShadow(Shader& shader);
 
     void setPosition(glm::vec3 pos) { position = pos; }
@@ -56,6 +58,9 @@ public:
 
     // 获取当前角色的碰撞盒
     AABB getBoundingBox() const;
+
+    // 绘制用的包围盒 (视锥剔除)：比碰撞盒大，包住举起的手臂和剑
+    AABB getRenderBounds() const;
 private:
     // 使用 shared_ptr 管理模型
     std::shared_ptr<TriMesh> torso;
@@ -95,9 +100,13 @@ private:
     float groundLevel;
 
     // 辅助绘制函数
-    static void drawLimb(const std::shared_ptr<TriMesh>& mesh, Shader& shader,
+    static void drawLimb(RenderQueue& queue, const std::shared_ptr<TriMesh>& mesh,
+                     const Shader& opaqueShader, const Shader& alphaTestShader,
                      glm::mat4 parentModel, glm::vec3 offset, float angle,
                      glm::vec3 rotateAxis);
+    // 按部件的贴图选择 Pass 和着色器变体后放进队列
+    static void queuePart(RenderQueue& queue, const TriMesh& mesh, const Shader& opaqueShader,
+                          const Shader& alphaTestShader, const glm::mat4& model);
 
 
     // 内部处理函数也只需接收 input
@@ -0,0 +1,34 @@
+#include "Core/EmbeddedAssets.h"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace EmbeddedAssets {
+
+// 资源只有几十个，线性查找就够了
+const Entry* find(const std::string& path) {
+    // 允许 "./assets/..." 这种写法
+    const char* key = path.c_str();
+    if (std::strncmp(key, "./", 2) == 0) key += 2;
+
+    for (size_t i = 0; i < ENTRY_COUNT; i++) {
+        if (std::strcmp(ENTRIES[i].path, key) == 0) return &ENTRIES[i];
+    }
+    return nullptr;
+}
+
+bool readText(const std::string& path, std::string& out) {
+    if (const Entry* entry = find(path)) {
+        out.assign(reinterpret_cast<const char*>(entry->data), entry->size);
+        return true;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::stringstream stream;
+    stream << file.rdbuf();
+    out = stream.str();
+    return true;
+}
+
+} // namespace EmbeddedAssets
@@ -0,0 +1,108 @@
+#include "Core/Frustum.h"
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FRUSTUM_USE_SSE 1
+#endif
+
+void BoundsList::clear() {
+    centerX.clear(); centerY.clear(); centerZ.clear();
+    extentX.clear(); extentY.clear(); extentZ.clear();
+}
+
+void BoundsList::push(const AABB& box) {
+    glm::vec3 center = (box.min + box.max) * 0.5f;
+    glm::vec3 extent = (box.max - box.min) * 0.5f;
+    centerX.push_back(center.x); centerY.push_back(center.y); centerZ.push_back(center.z);
+    extentX.push_back(extent.x); extentY.push_back(extent.y); extentZ.push_back(extent.z);
+}
+
+Frustum Frustum::fromMatrix(const glm::mat4& m) {
+    // glm 按列存储，第 i 行是 (m[0][i], m[1][i], m[2][i], m[3][i])
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0; // 左
+    frustum.planes[1] = row3 - row0; // 右
+    frustum.planes[2] = row3 + row1; // 下
+    frustum.planes[3] = row3 - row1; // 上
+    frustum.planes[4] = row3 + row2; // 近 (OpenGL 裁剪空间 z 在 [-w, w])
+    frustum.planes[5] = row3 - row2; // 远
+    for (glm::vec4& plane : frustum.planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) plane /= length;
+    }
+    return frustum;
+}
+
+// 盒子在平面上的投影半径 = |n| · extent；中心距离 + 半径 < 0 说明整个盒子在外侧
+bool Frustum::intersects(const AABB& box) const {
+    glm::vec3 center = (box.min + box.max) * 0.5f;
+    glm::vec3 extent = (box.max - box.min) * 0.5f;
+    for (const glm::vec4& plane : planes) {
+        glm::vec3 normal(plane);
+        float distance = glm::dot(normal, center) + plane.w;
+        float radius = glm::dot(glm::abs(normal), extent);
+        if (distance + radius < 0.0f) return false;
+    }
+    return true;
+}
+
+void Frustum::cull(const BoundsList& boxes, std::vector<uint8_t>& visible) const {
+    const size_t count = boxes.size();
+    visible.resize(count);
+    size_t i = 0;
+
+#ifdef FRUSTUM_USE_SSE
+    // 平面系数广播到 4 个通道，每轮处理 4 个盒子；任一平面判为外侧即剔除
+    __m128 nx[6], ny[6], nz[6], nw[6], ax[6], ay[6], az[6];
+    for (int p = 0; p < 6; p++) {
+        nx[p] = _mm_set1_ps(planes[p].x);
+        ny[p] = _mm_set1_ps(planes[p].y);
+        nz[p] = _mm_set1_ps(planes[p].z);
+        nw[p] = _mm_set1_ps(planes[p].w);
+        ax[p] = _mm_set1_ps(std::fabs(planes[p].x));
+        ay[p] = _mm_set1_ps(std::fabs(planes[p].y));
+        az[p] = _mm_set1_ps(std::fabs(planes[p].z));
+    }
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 cx = _mm_loadu_ps(&boxes.centerX[i]);
+        __m128 cy = _mm_loadu_ps(&boxes.centerY[i]);
+        __m128 cz = _mm_loadu_ps(&boxes.centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&boxes.extentX[i]);
+        __m128 ey = _mm_loadu_ps(&boxes.extentY[i]);
+        __m128 ez = _mm_loadu_ps(&boxes.extentZ[i]);
+
+        __m128 outside = zero;
+        for (int p = 0; p < 6; p++) {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], cx), _mm_mul_ps(ny[p], cy)),
+                                         _mm_add_ps(_mm_mul_ps(nz[p], cz), nw[p]));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[p], ex), _mm_mul_ps(ay[p], ey)),
+                                       _mm_mul_ps(az[p], ez));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        int mask = _mm_movemask_ps(outside);
+        visible[i + 0] = (mask & 1) ? 0 : 1;
+        visible[i + 1] = (mask & 2) ? 0 : 1;
+        visible[i + 2] = (mask & 4) ? 0 : 1;
+        visible[i + 3] = (mask & 8) ? 0 : 1;
+    }
+#endif
+
+    // 剩下不足 4 个 (或不支持 SSE) 逐个判断
+    for (; i < count; i++) {
+        AABB box;
+        glm::vec3 center(boxes.centerX[i], boxes.centerY[i], boxes.centerZ[i]);
+        glm::vec3 extent(boxes.extentX[i], boxes.extentY[i], boxes.extentZ[i]);
+        box.min = center - extent;
+        box.max = center + extent;
+        visible[i] = intersects(box) ? 1 : 0;
+    }
+}
@@ -0,0 +1,74 @@
+#include "Core/GLExtensions.h"
+#include "Vendor/glad/glad.h"
+#include <GLFW/glfw3.h>
+#include <set>
+#include <string>
+
+namespace GLExtensions {
+
+// Core Profile 下 glGetString(GL_EXTENSIONS) 已被移除，只能逐个查询
+static const std::set<std::string> &getExtensionSet()
+{
+    static std::set<std::string> extensions = [] {
+        std::set<std::string> result;
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; i++) {
+            const GLubyte *name = glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i));
+            if (name) result.insert(reinterpret_cast<const char *>(name));
+        }
+        return result;
+    }();
+    return extensions;
+}
+
+bool has(const char *name)
+{
+    return getExtensionSet().count(name) != 0;
+}
+
+bool hasS3TC()
+{
+    return has("GL_EXT_texture_compression_s3tc");
+}
+
+const ProgramBinaryApi *getProgramBinaryApi()
+{
+    static const ProgramBinaryApi *api = []() -> const ProgramBinaryApi * {
+        bool core41 = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 1);
+        if (!core41 && !has("GL_ARB_get_program_binary")) return nullptr;
+
+        // 有的驱动 (例如部分 Mesa) 宣称支持扩展但一种格式也不提供
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        if (formats <= 0) return nullptr;
+
+        static ProgramBinaryApi functions;
+        functions.getProgramBinary = reinterpret_cast<decltype(functions.getProgramBinary)>(glfwGetProcAddress("glGetProgramBinary"));
+        functions.programBinary = reinterpret_cast<decltype(functions.programBinary)>(glfwGetProcAddress("glProgramBinary"));
+        functions.programParameteri = reinterpret_cast<decltype(functions.programParameteri)>(glfwGetProcAddress("glProgramParameteri"));
+        if (!functions.getProgramBinary || !functions.programBinary || !functions.programParameteri) return nullptr;
+        return &functions;
+    }();
+    return api;
+}
+
+bool enableParallelShaderCompile()
+{
+    static const bool enabled = [] {
+        const char *entry = nullptr;
+        if (has("GL_KHR_parallel_shader_compile")) entry = "glMaxShaderCompilerThreadsKHR";
+        else if (has("GL_ARB_parallel_shader_compile")) entry = "glMaxShaderCompilerThreadsARB";
+        if (!entry) return false;
+
+        typedef void (APIENTRYP MaxShaderCompilerThreadsProc)(GLuint count);
+        auto maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(glfwGetProcAddress(entry));
+        if (!maxShaderCompilerThreads) return false;
+        // 0xFFFFFFFF: 线程数由驱动决定
+        maxShaderCompilerThreads(0xFFFFFFFFu);
+        return true;
+    }();
+    return enabled;
+}
+
+} // namespace GLExtensions
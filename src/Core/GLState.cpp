@@ -0,0 +1,159 @@
+#include "Core/GLState.h"
+
+namespace GLState {
+
+// 未知状态 (启动时或 invalidate 之后)，和任何真实的值都不相等
+static const GLuint UNKNOWN = 0xFFFFFFFFu;
+// 跟踪的纹理单元数 (更高的单元不缓存，每次都下发)
+static const GLuint MAX_TRACKED_UNITS = 32;
+
+// 每个单元分别记录 2D 和立方体贴图的绑定
+enum TextureSlot { SLOT_2D = 0, SLOT_CUBE_MAP = 1, SLOT_COUNT = 2 };
+
+struct State {
+    GLuint program = UNKNOWN;
+    GLuint vertexArray = UNKNOWN;
+    GLuint activeUnit = UNKNOWN; // 从 0 开始的单元号
+    GLuint textures[MAX_TRACKED_UNITS][SLOT_COUNT];
+    GLuint drawFramebuffer = UNKNOWN;
+    GLuint readFramebuffer = UNKNOWN;
+    GLenum depthFunc = UNKNOWN;
+
+    State() { resetTextures(); }
+    void resetTextures() {
+        for (auto &unit : textures)
+            for (GLuint &texture : unit) texture = UNKNOWN;
+    }
+};
+
+static State state;
+static Counters current;
+static Counters lastFrame;
+
+static int slotOf(GLenum target)
+{
+    if (target == GL_TEXTURE_2D) return SLOT_2D;
+    if (target == GL_TEXTURE_CUBE_MAP) return SLOT_CUBE_MAP;
+    return -1;
+}
+
+// 值相同返回 false (计为跳过)，否则记下新值并返回 true
+template <typename T>
+static bool change(T &cached, T value)
+{
+    if (cached == value) {
+        current.elided++;
+        return false;
+    }
+    cached = value;
+    current.issued++;
+    return true;
+}
+
+void useProgram(GLuint program)
+{
+    if (change(state.program, program)) glUseProgram(program);
+}
+
+void bindVertexArray(GLuint vao)
+{
+    if (change(state.vertexArray, vao)) glBindVertexArray(vao);
+}
+
+void activeTexture(GLenum unit)
+{
+    if (change(state.activeUnit, static_cast<GLuint>(unit - GL_TEXTURE0))) glActiveTexture(unit);
+}
+
+void bindTexture(GLenum target, GLuint texture)
+{
+    int slot = slotOf(target);
+    if (slot < 0 || state.activeUnit >= MAX_TRACKED_UNITS) {
+        current.issued++;
+        glBindTexture(target, texture);
+        return;
+    }
+    if (change(state.textures[state.activeUnit][slot], texture)) glBindTexture(target, texture);
+}
+
+void bindTextureUnit(GLuint unit, GLenum target, GLuint texture)
+{
+    int slot = slotOf(target);
+    if (slot >= 0 && unit < MAX_TRACKED_UNITS && state.textures[unit][slot] == texture) {
+        current.elided++;
+        return;
+    }
+    activeTexture(GL_TEXTURE0 + unit);
+    bindTexture(target, texture);
+}
+
+void bindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    bool draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+    bool read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+    if ((!draw || state.drawFramebuffer == framebuffer) && (!read || state.readFramebuffer == framebuffer)) {
+        current.elided++;
+        return;
+    }
+    if (draw) state.drawFramebuffer = framebuffer;
+    if (read) state.readFramebuffer = framebuffer;
+    current.issued++;
+    glBindFramebuffer(target, framebuffer);
+}
+
+void depthFunc(GLenum func)
+{
+    if (change(state.depthFunc, func)) glDepthFunc(func);
+}
+
+void deleteProgram(GLuint program)
+{
+    if (state.program == program) state.program = UNKNOWN;
+    glDeleteProgram(program);
+}
+
+void deleteVertexArrays(GLsizei count, const GLuint *vaos)
+{
+    // 删除当前绑定的 VAO 后 GL 会退回 0
+    for (GLsizei i = 0; i < count; i++)
+        if (vaos[i] == state.vertexArray) state.vertexArray = 0;
+    glDeleteVertexArrays(count, vaos);
+}
+
+void deleteTextures(GLsizei count, const GLuint *textures)
+{
+    for (GLsizei i = 0; i < count; i++) {
+        if (textures[i] == 0) continue;
+        for (auto &unit : state.textures)
+            for (GLuint &texture : unit)
+                if (texture == textures[i]) texture = 0;
+    }
+    glDeleteTextures(count, textures);
+}
+
+void deleteFramebuffers(GLsizei count, const GLuint *framebuffers)
+{
+    for (GLsizei i = 0; i < count; i++) {
+        if (framebuffers[i] == state.drawFramebuffer) state.drawFramebuffer = 0;
+        if (framebuffers[i] == state.readFramebuffer) state.readFramebuffer = 0;
+    }
+    glDeleteFramebuffers(count, framebuffers);
+}
+
+void invalidate()
+{
+    state = State();
+}
+
+void beginFrame()
+{
+    lastFrame = current;
+    current = Counters();
+}
+
+const Counters &getLastFrameCounters()
+{
+    return lastFrame;
+}
+
+} // namespace GLState
@@ -0,0 +1,214 @@
+#include "Core/Impostor.h"
+#include "Core/TriMesh.h"
+#include "Core/GLState.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// 烘焙时正交投影比包围球略大一点，给 mipmap 留出边距
+static const float BAKE_MARGIN = 1.05f;
+
+// 每个 impostor 每帧都要设置的 uniform
+static constexpr Uniform<glm::mat4> U_MODEL("model");
+static constexpr Uniform<glm::vec3> U_CENTER("impostorCenter");
+static constexpr Uniform<glm::vec3> U_RIGHT("impostorRight");
+static constexpr Uniform<glm::vec3> U_UP("impostorUp");
+static constexpr Uniform<glm::vec2> U_FRAME_OFFSET("frameOffset");
+static constexpr Uniform<float> U_FRAME_SCALE("frameScale");
+static constexpr Uniform<int> U_ALBEDO("impostorAlbedo");
+static constexpr Uniform<int> U_NORMAL("impostorNormal");
+
+Impostor::Impostor()
+    : albedoTexture(0), normalTexture(0), quadVAO(0), quadVBO(0),
+      gridSize(0), center(0.0f), radius(0.0f) {}
+
+Impostor::~Impostor()
+{
+    if (albedoTexture) GLState::deleteTextures(1, &albedoTexture);
+    if (normalTexture) GLState::deleteTextures(1, &normalTexture);
+    if (quadVAO) GLState::deleteVertexArrays(1, &quadVAO);
+    if (quadVBO) glDeleteBuffers(1, &quadVBO);
+}
+
+glm::vec2 Impostor::octEncode(const glm::vec3 &dir)
+{
+    glm::vec3 n = dir / (std::fabs(dir.x) + std::fabs(dir.y) + std::fabs(dir.z));
+    glm::vec2 p(n.x, n.z);
+    if (n.y < 0.0f) {
+        // 下半球沿对角线折叠到外侧
+        p = glm::vec2((1.0f - std::fabs(n.z)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                      (1.0f - std::fabs(n.x)) * (n.z >= 0.0f ? 1.0f : -1.0f));
+    }
+    return p * 0.5f + glm::vec2(0.5f);
+}
+
+glm::vec3 Impostor::octDecode(const glm::vec2 &uv)
+{
+    glm::vec2 p = uv * 2.0f - glm::vec2(1.0f);
+    glm::vec3 n(p.x, 1.0f - std::fabs(p.x) - std::fabs(p.y), p.y);
+    if (n.y < 0.0f) {
+        float x = (1.0f - std::fabs(n.z)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+        float z = (1.0f - std::fabs(n.x)) * (n.z >= 0.0f ? 1.0f : -1.0f);
+        n.x = x;
+        n.z = z;
+    }
+    return glm::normalize(n);
+}
+
+void Impostor::frameBasis(const glm::vec3 &dir, glm::vec3 &right, glm::vec3 &up)
+{
+    // 与 glm::lookAt 的约定一致：forward = -dir, right = forward x upHint
+    glm::vec3 forward = -dir;
+    glm::vec3 upHint = std::fabs(dir.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 0.0f, 1.0f);
+    right = glm::normalize(glm::cross(forward, upHint));
+    up = glm::cross(right, forward);
+}
+
+bool Impostor::bake(TriMesh &mesh, const Shader &bakeShader, int grid, int frameSize)
+{
+    gridSize = std::max(grid, 2);
+    center = (mesh.getMinBound() + mesh.getMaxBound()) * 0.5f;
+    radius = glm::length(mesh.getSize()) * 0.5f * BAKE_MARGIN;
+    if (radius <= 0.0f) return false;
+
+    const int atlasSize = gridSize * frameSize;
+
+    // 1. 图集纹理 + 深度缓冲
+    auto createAtlas = [atlasSize]() {
+        GLuint tex;
+        glGenTextures(1, &tex);
+        GLState::bindTexture(GL_TEXTURE_2D, tex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlasSize, atlasSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        // 只用前几级 mip，避免相邻帧在低分辨率下互相渗色
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 3);
+        return tex;
+    };
+    if (!albedoTexture) albedoTexture = createAtlas();
+    if (!normalTexture) normalTexture = createAtlas();
+
+    GLuint depthBuffer, fbo;
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, atlasSize, atlasSize);
+
+    glGenFramebuffers(1, &fbo);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, albedoTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, normalTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    const GLenum drawBuffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, drawBuffers);
+
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (complete) {
+        // 2. 保存现场
+        GLint oldViewport[4];
+        GLfloat oldClearColor[4];
+        glGetIntegerv(GL_VIEWPORT, oldViewport);
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, oldClearColor);
+
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        bakeShader.use();
+        glm::mat4 projection = glm::ortho(-radius, radius, -radius, radius, 0.0f, radius * 4.0f);
+        bakeShader.setMat4("projection", projection);
+
+        // 3. 每一帧：从八面体网格对应的方向用正交相机拍一张
+        for (int j = 0; j < gridSize; j++) {
+            for (int i = 0; i < gridSize; i++) {
+                glm::vec3 dir = octDecode(glm::vec2(i, j) / float(gridSize - 1));
+                glm::vec3 right, up;
+                frameBasis(dir, right, up);
+                glm::mat4 view = glm::lookAt(center + dir * (radius * 2.0f), center, up);
+                bakeShader.setMat4("view", view);
+
+                glViewport(i * frameSize, j * frameSize, frameSize, frameSize);
+                mesh.draw(bakeShader, glm::mat4(1.0f));
+            }
+        }
+
+        // 4. 恢复现场
+        glViewport(oldViewport[0], oldViewport[1], oldViewport[2], oldViewport[3]);
+        glClearColor(oldClearColor[0], oldClearColor[1], oldClearColor[2], oldClearColor[3]);
+    } else {
+        std::cerr << "[Impostor] Framebuffer incomplete, impostor disabled" << std::endl;
+    }
+
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::deleteFramebuffers(1, &fbo);
+    glDeleteRenderbuffers(1, &depthBuffer);
+
+    if (!complete) {
+        GLState::deleteTextures(1, &albedoTexture);
+        GLState::deleteTextures(1, &normalTexture);
+        albedoTexture = normalTexture = 0;
+        return false;
+    }
+
+    GLState::bindTexture(GL_TEXTURE_2D, albedoTexture);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    GLState::bindTexture(GL_TEXTURE_2D, normalTexture);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
+
+    // 5. 面片：[-1, 1]^2，实际朝向在绘制时由 uniform 决定
+    if (!quadVAO) {
+        const float quad[] = {-1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f};
+        glGenVertexArrays(1, &quadVAO);
+        glGenBuffers(1, &quadVBO);
+        GLState::bindVertexArray(quadVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void *)0);
+        GLState::bindVertexArray(0);
+    }
+
+#ifndef NDEBUG
+    std::cout << "[Impostor] Baked " << gridSize * gridSize << " views into " << atlasSize << "x" << atlasSize
+              << " atlas" << std::endl;
+#endif
+    return true;
+}
+
+void Impostor::draw(const Shader &shader, const glm::mat4 &model, const glm::vec3 &cameraPos) const
+{
+    if (!isReady()) return;
+
+    // 1. 把相机方向变换到模型局部空间，选出最接近的一帧
+    glm::vec3 worldCenter = glm::vec3(model * glm::vec4(center, 1.0f));
+    glm::mat3 linear = glm::mat3(model);
+    glm::vec3 localDir = glm::inverse(linear) * (cameraPos - worldCenter);
+    if (glm::length(localDir) < 1e-6f) return;
+    localDir = glm::normalize(localDir);
+
+    glm::vec2 gridPos = octEncode(localDir) * float(gridSize - 1);
+    int i = std::min(std::max(int(std::floor(gridPos.x + 0.5f)), 0), gridSize - 1);
+    int j = std::min(std::max(int(std::floor(gridPos.y + 0.5f)), 0), gridSize - 1);
+
+    // 2. 面片按该帧拍摄时的朝向摆放 (而不是严格朝向相机)，保证图像和几何一致
+    glm::vec3 frameDir = octDecode(glm::vec2(i, j) / float(gridSize - 1));
+    glm::vec3 right, up;
+    frameBasis(frameDir, right, up);
+
+    shader.set(U_MODEL, model);
+    shader.set(U_CENTER, center);
+    shader.set(U_RIGHT, right * radius);
+    shader.set(U_UP, up * radius);
+    shader.set(U_FRAME_OFFSET, glm::vec2(i, j) / float(gridSize));
+    shader.set(U_FRAME_SCALE, 1.0f / float(gridSize));
+
+    GLState::bindTextureUnit(0, GL_TEXTURE_2D, albedoTexture);
+    shader.set(U_ALBEDO, 0);
+    GLState::bindTextureUnit(1, GL_TEXTURE_2D, normalTexture);
+    shader.set(U_NORMAL, 1);
+
+    GLState::bindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+}
@@ -0,0 +1,116 @@
+#include "Core/MappedFile.h"
+#include <filesystem>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+#ifdef _WIN32
+        std::swap(fileHandle, other.fileHandle);
+        std::swap(mappingHandle, other.mappingHandle);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = view;
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后文件描述符就可以关掉了
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+
+    data = view;
+    size = static_cast<size_t>(st.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::close() {
+    if (!data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    munmap(data, size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+bool isCookedFresh(const std::string& cookedPath, const std::string& sourcePath) {
+    std::error_code ec;
+    auto cookedTime = std::filesystem::last_write_time(cookedPath, ec);
+    if (ec) return false;
+
+    auto sourceTime = std::filesystem::last_write_time(sourcePath, ec);
+    if (ec) return true;
+
+    return cookedTime >= sourceTime;
+}
@@ -0,0 +1,255 @@
+#include "Core/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MeshOptimizer {
+
+float computeACMR(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize) {
+    if (indices.size() < 3) return 0.0f;
+
+    // 记录每个顶点进入 FIFO 的时间戳，时间差 >= cacheSize 说明已被挤出
+    std::vector<size_t> entryTime(vertexCount, 0);
+    size_t time = cacheSize + 1;
+    size_t misses = 0;
+
+    for (unsigned int index : indices) {
+        if (time - entryTime[index] > cacheSize) {
+            entryTime[index] = time++;
+            misses++;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+// ---------------------------------------------------------------------------
+// Forsyth 顶点缓存优化
+// ---------------------------------------------------------------------------
+namespace {
+
+constexpr int kCacheSize = 32;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+
+float vertexScore(int cachePosition, unsigned int liveTriangles) {
+    if (liveTriangles == 0) return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // 刚用过的三个顶点属于上一个三角形，给固定分数，避免总是选择相邻条带
+            score = kLastTriScore;
+        } else {
+            const float scaler = 1.0f / (kCacheSize - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scaler, kCacheDecayPower);
+        }
+    }
+    // 剩余三角形越少的顶点越应该尽快处理掉
+    score += kValenceBoostScale * std::pow(static_cast<float>(liveTriangles), -kValenceBoostPower);
+    return score;
+}
+
+} // namespace
+
+void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    // 1. 顶点 -> 三角形邻接表 (CSR)
+    std::vector<unsigned int> liveTriangles(vertexCount, 0);
+    for (unsigned int index : indices) liveTriangles[index]++;
+
+    std::vector<unsigned int> adjacencyOffset(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) adjacencyOffset[v + 1] = adjacencyOffset[v] + liveTriangles[v];
+
+    std::vector<unsigned int> adjacency(indices.size());
+    std::vector<unsigned int> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < 3; k++) adjacency[fill[indices[t * 3 + k]]++] = static_cast<unsigned int>(t);
+    }
+
+    // 2. 初始分数
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) score[v] = vertexScore(-1, liveTriangles[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    for (size_t t = 0; t < triangleCount; t++) {
+        triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+    }
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+
+    // 模拟 LRU 缓存 (多留 3 个槽位给新加入的顶点)
+    std::vector<unsigned int> cache;
+    cache.reserve(kCacheSize + 3);
+
+    size_t scanCursor = 0; // 缓存里找不到候选时，线性扫描的起点
+    long bestTriangle = -1;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+        if (bestTriangle < 0) {
+            // 缓存里没有候选 (当前连通块画完了)：按原顺序取下一个未输出的三角形
+            // 不做全局最高分搜索，避免大量小连通块 (体素面片) 时退化成 O(n^2)
+            bestTriangle = static_cast<long>(scanCursor);
+        }
+
+        const size_t tri = static_cast<size_t>(bestTriangle);
+        emitted[tri] = true;
+        while (scanCursor < triangleCount && emitted[scanCursor]) scanCursor++;
+
+        // 3. 输出三角形，并把它的顶点移到缓存最前面
+        std::vector<unsigned int> newCache;
+        newCache.reserve(kCacheSize + 3);
+        for (int k = 0; k < 3; k++) {
+            unsigned int v = indices[tri * 3 + k];
+            result.push_back(v);
+            newCache.push_back(v);
+
+            // 从该顶点的存活列表中删除当前三角形
+            unsigned int begin = adjacencyOffset[v];
+            unsigned int end = begin + liveTriangles[v];
+            for (unsigned int i = begin; i < end; i++) {
+                if (adjacency[i] == tri) {
+                    std::swap(adjacency[i], adjacency[end - 1]);
+                    break;
+                }
+            }
+            liveTriangles[v]--;
+        }
+        for (unsigned int v : cache) {
+            if (std::find(newCache.begin(), newCache.end(), v) == newCache.end()) newCache.push_back(v);
+        }
+        cache.swap(newCache);
+
+        // 4. 更新缓存中顶点的分数，挤出缓存的顶点位置置为 -1
+        for (size_t i = 0; i < cache.size(); i++) {
+            unsigned int v = cache[i];
+            cachePosition[v] = i < static_cast<size_t>(kCacheSize) ? static_cast<int>(i) : -1;
+        }
+
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for (unsigned int v : cache) {
+            float newScore = vertexScore(cachePosition[v], liveTriangles[v]);
+            float delta = newScore - score[v];
+            score[v] = newScore;
+
+            unsigned int begin = adjacencyOffset[v];
+            unsigned int end = begin + liveTriangles[v];
+            for (unsigned int i = begin; i < end; i++) {
+                unsigned int t = adjacency[i];
+                triangleScore[t] += delta;
+                if (triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    bestTriangle = static_cast<long>(t);
+                }
+            }
+        }
+        if (cache.size() > static_cast<size_t>(kCacheSize)) cache.resize(kCacheSize);
+    }
+
+    indices.swap(result);
+}
+
+// ---------------------------------------------------------------------------
+// 过度绘制优化
+// ---------------------------------------------------------------------------
+void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<glm::vec3>& positions) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) return;
+
+    // 1. 切分簇：在 FIFO 缓存模拟中三个顶点全部未命中的位置切开
+    // 这些位置本来就要重新填充缓存，调整簇的先后顺序几乎不影响 ACMR
+    const unsigned int cacheSize = 16;
+    std::vector<size_t> entryTime(positions.size(), 0);
+    size_t time = cacheSize + 1;
+
+    std::vector<size_t> clusterStart;
+    for (size_t t = 0; t < triangleCount; t++) {
+        int misses = 0;
+        for (int k = 0; k < 3; k++) {
+            unsigned int v = indices[t * 3 + k];
+            if (time - entryTime[v] > cacheSize) {
+                entryTime[v] = time++;
+                misses++;
+            }
+        }
+        if (t == 0 || misses == 3) clusterStart.push_back(t);
+    }
+    if (clusterStart.size() < 2) return;
+    clusterStart.push_back(triangleCount);
+
+    // 2. 网格整体中心
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+    for (size_t t = 0; t < triangleCount; t++) {
+        const glm::vec3& a = positions[indices[t * 3]];
+        const glm::vec3& b = positions[indices[t * 3 + 1]];
+        const glm::vec3& c = positions[indices[t * 3 + 2]];
+        float area = glm::length(glm::cross(b - a, c - a));
+        meshCenter += (a + b + c) * (area / 3.0f);
+        meshArea += area;
+    }
+    if (meshArea <= 0.0f) return;
+    meshCenter /= meshArea;
+
+    // 3. 每个簇的排序指标：dot(簇中心 - 网格中心, 簇平均法线)
+    // 越大说明簇越靠外并朝外，越可能遮挡其他簇，应该先画
+    struct Cluster {
+        size_t begin, end;
+        float sortKey;
+    };
+    std::vector<Cluster> clusters;
+    clusters.reserve(clusterStart.size() - 1);
+
+    for (size_t c = 0; c + 1 < clusterStart.size(); c++) {
+        glm::vec3 center(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+        for (size_t t = clusterStart[c]; t < clusterStart[c + 1]; t++) {
+            const glm::vec3& a = positions[indices[t * 3]];
+            const glm::vec3& b = positions[indices[t * 3 + 1]];
+            const glm::vec3& p = positions[indices[t * 3 + 2]];
+            glm::vec3 n = glm::cross(b - a, p - a); // 长度 = 2 * 面积
+            float triArea = glm::length(n);
+            center += (a + b + p) * (triArea / 3.0f);
+            normal += n;
+            area += triArea;
+        }
+        float key = 0.0f;
+        if (area > 0.0f && glm::length(normal) > 0.0f) {
+            center /= area;
+            key = glm::dot(center - meshCenter, glm::normalize(normal));
+        }
+        clusters.push_back({clusterStart[c], clusterStart[c + 1], key});
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+    for (const auto& cluster : clusters) {
+        result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+    }
+    indices.swap(result);
+}
+
+// ---------------------------------------------------------------------------
+// 顶点读取优化
+// ---------------------------------------------------------------------------
+std::vector<unsigned int> optimizeVertexFetch(std::vector<unsigned int>& indices, size_t vertexCount) {
+    std::vector<unsigned int> remap(vertexCount, ~0u);
+    unsigned int next = 0;
+    for (unsigned int& index : indices) {
+        if (remap[index] == ~0u) remap[index] = next++;
+        index = remap[index];
+    }
+    return remap;
+}
+
+} // namespace MeshOptimizer
@@ -0,0 +1,290 @@
+#include "Core/MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+namespace MeshSimplifier {
+namespace {
+
+// 边界边额外的约束平面权重：越大越不容易把开放边界 (例如叶片边缘) 收缩掉
+constexpr double kBorderWeight = 10.0;
+
+// 对称 4x4 矩阵只存上三角 10 个元素，weight 为累计面积，用于把误差归一化成平均距离平方
+struct Quadric {
+    double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+    double a11 = 0, a12 = 0, a13 = 0;
+    double a22 = 0, a23 = 0;
+    double a33 = 0;
+    double weight = 0;
+
+    void addPlane(const glm::vec3& n, double d, double w) {
+        const double nx = n.x, ny = n.y, nz = n.z;
+        a00 += w * nx * nx; a01 += w * nx * ny; a02 += w * nx * nz; a03 += w * nx * d;
+        a11 += w * ny * ny; a12 += w * ny * nz; a13 += w * ny * d;
+        a22 += w * nz * nz; a23 += w * nz * d;
+        a33 += w * d * d;
+        weight += w;
+    }
+
+    void add(const Quadric& q) {
+        a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+        a11 += q.a11; a12 += q.a12; a13 += q.a13;
+        a22 += q.a22; a23 += q.a23;
+        a33 += q.a33;
+        weight += q.weight;
+    }
+
+    // 点到所有平面的加权距离平方之和 / 总权重
+    double evaluate(const glm::vec3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        double e = a00 * x * x + 2 * a01 * x * y + 2 * a02 * x * z + 2 * a03 * x
+                 + a11 * y * y + 2 * a12 * y * z + 2 * a13 * y
+                 + a22 * z * z + 2 * a23 * z
+                 + a33;
+        return weight > 0 ? std::fabs(e) / weight : 0.0;
+    }
+};
+
+struct Collapse {
+    double cost;
+    uint32_t from, to;
+    uint32_t fromStamp, toStamp;
+    bool operator>(const Collapse& other) const { return cost > other.cost; }
+};
+
+struct PositionHash {
+    size_t operator()(const glm::vec3& p) const {
+        uint32_t bits[3];
+        std::memcpy(bits, &p, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    }
+};
+
+inline uint64_t edgeKey(uint32_t a, uint32_t b) {
+    if (a > b) std::swap(a, b);
+    return (uint64_t(a) << 32) | b;
+}
+
+} // namespace
+
+std::vector<unsigned int> simplify(const std::vector<unsigned int>& indices,
+                                   const std::vector<glm::vec3>& positions,
+                                   const std::vector<glm::vec3>& normals,
+                                   const std::vector<glm::vec2>& texcoords,
+                                   const std::vector<glm::vec3>& colors,
+                                   size_t targetIndexCount, float targetError,
+                                   float* resultError) {
+    if (resultError) *resultError = 0.0f;
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || targetIndexCount >= indices.size()) return indices;
+
+    // 1. 按位置合并顶点：接缝两侧的顶点属于同一个"位置组"，折叠在组上进行，避免撕开接缝
+    std::unordered_map<glm::vec3, uint32_t, PositionHash> groupIds;
+    std::vector<uint32_t> groupOf(positions.size());
+    std::vector<glm::vec3> groupPos;
+    std::vector<std::vector<uint32_t>> groupVerts;
+    for (size_t v = 0; v < positions.size(); v++) {
+        auto inserted = groupIds.emplace(positions[v], static_cast<uint32_t>(groupPos.size()));
+        if (inserted.second) {
+            groupPos.push_back(positions[v]);
+            groupVerts.emplace_back();
+        }
+        groupOf[v] = inserted.first->second;
+        groupVerts[groupOf[v]].push_back(static_cast<uint32_t>(v));
+    }
+    const size_t groupCount = groupPos.size();
+
+    glm::vec3 minP(1e30f), maxP(-1e30f);
+    for (const auto& p : groupPos) {
+        minP = glm::min(minP, p);
+        maxP = glm::max(maxP, p);
+    }
+    const double extent = glm::length(maxP - minP);
+    if (extent <= 0.0) return indices;
+    const double errorLimit = double(targetError) * extent;
+    const double errorLimitSq = errorLimit * errorLimit;
+
+    // 2. 三角形 (组空间) 与邻接表
+    std::vector<uint32_t> tris(triangleCount * 3);
+    std::vector<bool> alive(triangleCount, true);
+    std::vector<std::vector<uint32_t>> groupTris(groupCount);
+    size_t liveCount = 0;
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < 3; k++) tris[t * 3 + k] = groupOf[indices[t * 3 + k]];
+        uint32_t a = tris[t * 3], b = tris[t * 3 + 1], c = tris[t * 3 + 2];
+        if (a == b || b == c || a == c) {
+            alive[t] = false;
+            continue;
+        }
+        liveCount++;
+        for (int k = 0; k < 3; k++) groupTris[tris[t * 3 + k]].push_back(static_cast<uint32_t>(t));
+    }
+
+    // 3. 误差二次型：每个三角形所在平面 (按面积加权) + 边界边的垂直约束平面
+    std::vector<Quadric> quadrics(groupCount);
+    std::unordered_map<uint64_t, uint32_t> edgeUse;
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (!alive[t]) continue;
+        for (int k = 0; k < 3; k++) edgeUse[edgeKey(tris[t * 3 + k], tris[t * 3 + (k + 1) % 3])]++;
+    }
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (!alive[t]) continue;
+        glm::vec3 p0 = groupPos[tris[t * 3]], p1 = groupPos[tris[t * 3 + 1]], p2 = groupPos[tris[t * 3 + 2]];
+        glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+        float len = glm::length(n);
+        if (len <= 0.0f) continue;
+        n /= len;
+        double area = len * 0.5;
+        for (int k = 0; k < 3; k++) quadrics[tris[t * 3 + k]].addPlane(n, -glm::dot(n, p0), area);
+
+        for (int k = 0; k < 3; k++) {
+            uint32_t a = tris[t * 3 + k], b = tris[t * 3 + (k + 1) % 3];
+            if (edgeUse[edgeKey(a, b)] != 1) continue;
+            glm::vec3 pa = groupPos[a], pb = groupPos[b];
+            glm::vec3 edge = pb - pa;
+            glm::vec3 bn = glm::cross(edge, n);
+            float bl = glm::length(bn);
+            if (bl <= 0.0f) continue;
+            bn /= bl;
+            double w = glm::dot(edge, edge) * kBorderWeight;
+            quadrics[a].addPlane(bn, -glm::dot(bn, pa), w);
+            quadrics[b].addPlane(bn, -glm::dot(bn, pa), w);
+        }
+    }
+
+    // 4. 候选折叠 (小根堆，过期条目靠时间戳惰性丢弃)
+    std::vector<bool> removed(groupCount, false);
+    std::vector<uint32_t> stamp(groupCount, 0);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+
+    auto pushEdge = [&](uint32_t a, uint32_t b) {
+        Quadric q = quadrics[a];
+        q.add(quadrics[b]);
+        double costToB = q.evaluate(groupPos[b]);
+        double costToA = q.evaluate(groupPos[a]);
+        if (costToB <= costToA) heap.push({costToB, a, b, stamp[a], stamp[b]});
+        else heap.push({costToA, b, a, stamp[b], stamp[a]});
+    };
+
+    for (const auto& entry : edgeUse) {
+        pushEdge(static_cast<uint32_t>(entry.first >> 32), static_cast<uint32_t>(entry.first & 0xFFFFFFFFu));
+    }
+
+    auto neighbors = [&](uint32_t g, std::vector<uint32_t>& out) {
+        out.clear();
+        for (uint32_t t : groupTris[g]) {
+            if (!alive[t]) continue;
+            for (int k = 0; k < 3; k++) {
+                uint32_t n = tris[t * 3 + k];
+                if (n != g) out.push_back(n);
+            }
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    };
+
+    std::vector<uint32_t> fromNeighbors, toNeighbors, common;
+    double maxError = 0.0;
+
+    while (liveCount * 3 > targetIndexCount && !heap.empty()) {
+        Collapse c = heap.top();
+        heap.pop();
+        if (removed[c.from] || removed[c.to] || stamp[c.from] != c.fromStamp || stamp[c.to] != c.toStamp) continue;
+        if (c.cost > errorLimitSq) break;
+
+        // 拓扑检查 (link condition)：两端共同的邻居只能是共享三角形的第三个顶点，否则会折出非流形
+        neighbors(c.from, fromNeighbors);
+        neighbors(c.to, toNeighbors);
+        if (!std::binary_search(fromNeighbors.begin(), fromNeighbors.end(), c.to)) continue;
+        common.clear();
+        std::set_intersection(fromNeighbors.begin(), fromNeighbors.end(), toNeighbors.begin(), toNeighbors.end(),
+                              std::back_inserter(common));
+        size_t shared = 0;
+        for (uint32_t t : groupTris[c.from]) {
+            if (!alive[t]) continue;
+            if (tris[t * 3] == c.to || tris[t * 3 + 1] == c.to || tris[t * 3 + 2] == c.to) shared++;
+        }
+        if (common.size() > shared) continue;
+
+        // 几何检查：折叠后不能有三角形翻面
+        bool flips = false;
+        for (uint32_t t : groupTris[c.from]) {
+            if (!alive[t] || flips) continue;
+            const uint32_t* tri = &tris[t * 3];
+            if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) continue;
+            glm::vec3 p[3], q[3];
+            for (int k = 0; k < 3; k++) {
+                p[k] = groupPos[tri[k]];
+                q[k] = tri[k] == c.from ? groupPos[c.to] : p[k];
+            }
+            glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+            glm::vec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+            flips = glm::dot(before, after) <= 0.0f;
+        }
+        if (flips) continue;
+
+        // 执行折叠：from 的三角形改指向 to，共享三角形退化消失
+        for (uint32_t t : groupTris[c.from]) {
+            if (!alive[t]) continue;
+            uint32_t* tri = &tris[t * 3];
+            if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+                alive[t] = false;
+                liveCount--;
+                continue;
+            }
+            for (int k = 0; k < 3; k++) if (tri[k] == c.from) tri[k] = c.to;
+            groupTris[c.to].push_back(t);
+        }
+        groupTris[c.from].clear();
+        removed[c.from] = true;
+        quadrics[c.to].add(quadrics[c.from]);
+        stamp[c.to]++;
+        maxError = std::max(maxError, c.cost);
+
+        // 清理失效的邻接项，并重新评估 to 周围的边
+        auto& list = groupTris[c.to];
+        list.erase(std::remove_if(list.begin(), list.end(), [&](uint32_t t) { return !alive[t]; }), list.end());
+        neighbors(c.to, toNeighbors);
+        for (uint32_t n : toNeighbors) pushEdge(c.to, n);
+    }
+
+    // 5. 输出：组 -> 原顶点。角上原顶点仍在原位置时保持不变，否则在目标位置上挑属性最接近的顶点
+    auto attributeDistance = [&](uint32_t a, uint32_t b) {
+        glm::vec3 dn = normals[a] - normals[b];
+        glm::vec2 dt = texcoords[a] - texcoords[b];
+        glm::vec3 dc = colors[a] - colors[b];
+        return glm::dot(dn, dn) + glm::dot(dt, dt) + glm::dot(dc, dc);
+    };
+
+    std::vector<unsigned int> result;
+    result.reserve(liveCount * 3);
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (!alive[t]) continue;
+        for (int k = 0; k < 3; k++) {
+            uint32_t original = indices[t * 3 + k];
+            uint32_t group = tris[t * 3 + k];
+            if (groupOf[original] == group) {
+                result.push_back(original);
+                continue;
+            }
+            uint32_t best = groupVerts[group][0];
+            float bestDistance = attributeDistance(original, best);
+            for (uint32_t candidate : groupVerts[group]) {
+                float d = attributeDistance(original, candidate);
+                if (d < bestDistance) {
+                    bestDistance = d;
+                    best = candidate;
+                }
+            }
+            result.push_back(best);
+        }
+    }
+
+    if (resultError) *resultError = static_cast<float>(std::sqrt(maxError) / extent);
+    return result;
+}
+
+} // namespace MeshSimplifier
@@ -0,0 +1,617 @@
+#include "Core/ObjParser.h"
+#include "Core/MappedFile.h"
+#include "Core/ThreadPool.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ObjParser {
+namespace {
+
+// 小于这个大小的块不值得再拆给新线程
+constexpr size_t kMinChunkBytes = 64 * 1024;
+constexpr int kMissing = INT_MIN;
+
+// 相对索引 (负数) 标记：合并时需要加上前面各块的元素数量
+constexpr uint8_t kRelativeVertex = 1;
+constexpr uint8_t kRelativeTexcoord = 2;
+constexpr uint8_t kRelativeNormal = 4;
+
+// ---------------------------------------------------------------------------
+// 数值扫描
+// ---------------------------------------------------------------------------
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+inline bool isDigit(char c) { return static_cast<unsigned char>(c - '0') < 10u; }
+
+inline const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && isSpace(*p)) ++p;
+    return p;
+}
+
+// 10^0 ~ 10^22 在 double 中可以精确表示
+const double kPow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// 快速浮点扫描：整数尾数 (最多 19 位有效数字) + 十进制指数，一次乘/除还原
+// 成功返回数字之后的位置，失败返回 nullptr
+const char* scanFloat(const char* p, const char* end, float& out) {
+    p = skipSpaces(p, end);
+    if (p >= end) return nullptr;
+
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool any = false;
+
+    while (p < end && isDigit(*p)) {
+        any = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+            if (mantissa) digits++;
+        } else {
+            exponent++;
+        }
+        ++p;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && isDigit(*p)) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                if (mantissa) digits++;
+                exponent--;
+            }
+            ++p;
+        }
+    }
+    if (!any) return nullptr;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        bool expNegative = false;
+        if (q < end && (*q == '-' || *q == '+')) {
+            expNegative = (*q == '-');
+            ++q;
+        }
+        if (q < end && isDigit(*q)) {
+            int e = 0;
+            while (q < end && isDigit(*q)) {
+                if (e < 10000) e = e * 10 + (*q - '0');
+                ++q;
+            }
+            exponent += expNegative ? -e : e;
+            p = q;
+        }
+    }
+
+    double value = static_cast<double>(mantissa);
+    if (mantissa != 0 && exponent != 0) {
+        if (exponent > 0) {
+            value *= exponent <= 22 ? kPow10[exponent] : std::pow(10.0, exponent);
+        } else {
+            value /= -exponent <= 22 ? kPow10[-exponent] : std::pow(10.0, -exponent);
+        }
+    }
+    out = static_cast<float>(negative ? -value : value);
+    return p;
+}
+
+const char* scanInt(const char* p, const char* end, int& out) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+    if (p >= end || !isDigit(*p)) return nullptr;
+
+    int64_t value = 0;
+    while (p < end && isDigit(*p)) {
+        if (value < INT_MAX) value = value * 10 + (*p - '0');
+        ++p;
+    }
+    value = std::min<int64_t>(value, INT_MAX);
+    out = static_cast<int>(negative ? -value : value);
+    return p;
+}
+
+// 取行内剩余部分并去掉首尾空白
+std::string restOfLine(const char* p, const char* end) {
+    p = skipSpaces(p, end);
+    while (end > p && isSpace(end[-1])) --end;
+    return std::string(p, end);
+}
+
+bool keywordIs(const char* p, const char* end, const char* keyword) {
+    size_t len = std::strlen(keyword);
+    return static_cast<size_t>(end - p) >= len && std::memcmp(p, keyword, len) == 0 &&
+           (static_cast<size_t>(end - p) == len || isSpace(p[len]));
+}
+
+// ---------------------------------------------------------------------------
+// 分块解析
+// ---------------------------------------------------------------------------
+struct Polygon {
+    uint32_t firstCorner;
+    uint32_t cornerCount;
+    int materialSlot; // 指向 Chunk::materialNames，-1 表示沿用上一块末尾的材质
+};
+
+struct Chunk {
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texcoords;
+
+    std::vector<Index> corners;
+    std::vector<uint8_t> relative; // 与 corners 一一对应
+    std::vector<Polygon> polygons;
+
+    std::vector<std::string> materialNames; // usemtl 出现顺序
+    std::vector<std::string> materialLibs;  // mtllib 行
+    int lastSlot = -1;                      // 块末尾生效的 usemtl
+
+    std::string error;
+
+    // 三角化结果
+    std::vector<Index> triangles;
+    std::vector<int> triangleMaterials;
+};
+
+// 把 OBJ 的 1-based / 负数索引转换为 0-based；负数先按块内计数转换并打上相对标记
+bool fixIndex(int raw, size_t localCount, uint8_t flag, int& out, uint8_t& relativeMask) {
+    if (raw > 0) {
+        out = raw - 1;
+        return true;
+    }
+    if (raw < 0) {
+        out = static_cast<int>(localCount) + raw;
+        relativeMask |= flag;
+        return true;
+    }
+    return false; // 0 不是合法的 OBJ 索引
+}
+
+void parseFace(const char* p, const char* end, Chunk& chunk, int currentSlot) {
+    Polygon polygon;
+    polygon.firstCorner = static_cast<uint32_t>(chunk.corners.size());
+    polygon.cornerCount = 0;
+    polygon.materialSlot = currentSlot;
+
+    const size_t vCount = chunk.positions.size() / 3;
+    const size_t vtCount = chunk.texcoords.size() / 2;
+    const size_t vnCount = chunk.normals.size() / 3;
+
+    while (true) {
+        p = skipSpaces(p, end);
+        if (p >= end) break;
+
+        Index index{kMissing, kMissing, kMissing};
+        uint8_t mask = 0;
+        int raw = 0;
+
+        const char* next = scanInt(p, end, raw);
+        if (!next || !fixIndex(raw, vCount, kRelativeVertex, index.vertex, mask)) {
+            chunk.error = "Invalid face index: " + restOfLine(p, end);
+            return;
+        }
+        p = next;
+
+        if (p < end && *p == '/') {
+            ++p;
+            if (p < end && *p != '/') {
+                // v/vt
+                next = scanInt(p, end, raw);
+                if (!next || !fixIndex(raw, vtCount, kRelativeTexcoord, index.texcoord, mask)) {
+                    chunk.error = "Invalid texcoord index: " + restOfLine(p, end);
+                    return;
+                }
+                p = next;
+            }
+            if (p < end && *p == '/') {
+                // v//vn 或 v/vt/vn
+                ++p;
+                next = scanInt(p, end, raw);
+                if (!next || !fixIndex(raw, vnCount, kRelativeNormal, index.normal, mask)) {
+                    chunk.error = "Invalid normal index: " + restOfLine(p, end);
+                    return;
+                }
+                p = next;
+            }
+        }
+
+        chunk.corners.push_back(index);
+        chunk.relative.push_back(mask);
+        polygon.cornerCount++;
+    }
+
+    if (polygon.cornerCount >= 3) {
+        chunk.polygons.push_back(polygon);
+    } else {
+        // 点/线退化面直接丢弃
+        chunk.corners.resize(polygon.firstCorner);
+        chunk.relative.resize(polygon.firstCorner);
+    }
+}
+
+void parseChunk(const char* begin, const char* end, Chunk& chunk) {
+    int currentSlot = -1;
+    const char* line = begin;
+
+    while (line < end && chunk.error.empty()) {
+        // memchr 由 libc 用 SIMD 实现，是整个解析里最热的循环
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        const char* lineEnd = newline ? newline : end;
+
+        const char* p = skipSpaces(line, lineEnd);
+        if (p < lineEnd && *p != '#') {
+            if (keywordIs(p, lineEnd, "v")) {
+                float xyz[3] = {0.0f, 0.0f, 0.0f};
+                const char* q = p + 1;
+                for (float& c : xyz) {
+                    const char* r = scanFloat(q, lineEnd, c);
+                    if (!r) break;
+                    q = r;
+                }
+                chunk.positions.insert(chunk.positions.end(), xyz, xyz + 3);
+            } else if (keywordIs(p, lineEnd, "vn")) {
+                float xyz[3] = {0.0f, 0.0f, 0.0f};
+                const char* q = p + 2;
+                for (float& c : xyz) {
+                    const char* r = scanFloat(q, lineEnd, c);
+                    if (!r) break;
+                    q = r;
+                }
+                chunk.normals.insert(chunk.normals.end(), xyz, xyz + 3);
+            } else if (keywordIs(p, lineEnd, "vt")) {
+                float uv[2] = {0.0f, 0.0f};
+                const char* q = p + 2;
+                for (float& c : uv) {
+                    const char* r = scanFloat(q, lineEnd, c);
+                    if (!r) break;
+                    q = r;
+                }
+                chunk.texcoords.insert(chunk.texcoords.end(), uv, uv + 2);
+            } else if (keywordIs(p, lineEnd, "f")) {
+                parseFace(p + 1, lineEnd, chunk, currentSlot);
+            } else if (keywordIs(p, lineEnd, "usemtl")) {
+                chunk.materialNames.push_back(restOfLine(p + 6, lineEnd));
+                currentSlot = static_cast<int>(chunk.materialNames.size()) - 1;
+            } else if (keywordIs(p, lineEnd, "mtllib")) {
+                chunk.materialLibs.push_back(restOfLine(p + 6, lineEnd));
+            }
+            // o / g / s / l / p 等对渲染无影响，忽略
+        }
+
+        line = newline ? newline + 1 : end;
+    }
+    chunk.lastSlot = currentSlot;
+}
+
+// ---------------------------------------------------------------------------
+// 三角化 (与 TinyObj 的默认行为一致)
+// ---------------------------------------------------------------------------
+void emitTriangle(Chunk& chunk, const Index& a, const Index& b, const Index& c, int material) {
+    chunk.triangles.push_back(a);
+    chunk.triangles.push_back(b);
+    chunk.triangles.push_back(c);
+    chunk.triangleMaterials.push_back(material);
+}
+
+void triangulatePolygon(Chunk& chunk, const Index* corners, uint32_t count, int material,
+                        const std::vector<float>& positions) {
+    auto position = [&](const Index& index, int axis) { return positions[index.vertex * 3 + axis]; };
+
+    if (count == 3) {
+        emitTriangle(chunk, corners[0], corners[1], corners[2], material);
+        return;
+    }
+
+    if (count == 4) {
+        // 四边形沿较短的对角线切开
+        float sqr02 = 0.0f, sqr13 = 0.0f;
+        for (int axis = 0; axis < 3; axis++) {
+            float e02 = position(corners[2], axis) - position(corners[0], axis);
+            float e13 = position(corners[3], axis) - position(corners[1], axis);
+            sqr02 += e02 * e02;
+            sqr13 += e13 * e13;
+        }
+        if (sqr02 < sqr13) {
+            emitTriangle(chunk, corners[0], corners[1], corners[2], material);
+            emitTriangle(chunk, corners[0], corners[2], corners[3], material);
+        } else {
+            emitTriangle(chunk, corners[0], corners[1], corners[3], material);
+            emitTriangle(chunk, corners[1], corners[2], corners[3], material);
+        }
+        return;
+    }
+
+    // 多边形：投影到主平面后做耳切 (Newell 法线决定投影轴和朝向)
+    float normal[3] = {0.0f, 0.0f, 0.0f};
+    for (uint32_t i = 0; i < count; i++) {
+        const Index& a = corners[i];
+        const Index& b = corners[(i + 1) % count];
+        normal[0] += (position(a, 1) - position(b, 1)) * (position(a, 2) + position(b, 2));
+        normal[1] += (position(a, 2) - position(b, 2)) * (position(a, 0) + position(b, 0));
+        normal[2] += (position(a, 0) - position(b, 0)) * (position(a, 1) + position(b, 1));
+    }
+    int dropAxis = 0;
+    for (int axis = 1; axis < 3; axis++) {
+        if (std::fabs(normal[axis]) > std::fabs(normal[dropAxis])) dropAxis = axis;
+    }
+    const int axisU = (dropAxis + 1) % 3;
+    const int axisV = (dropAxis + 2) % 3;
+    const float orientation = normal[dropAxis] >= 0.0f ? 1.0f : -1.0f;
+
+    auto cross2 = [&](const Index& o, const Index& a, const Index& b) {
+        float ax = position(a, axisU) - position(o, axisU), ay = position(a, axisV) - position(o, axisV);
+        float bx = position(b, axisU) - position(o, axisU), by = position(b, axisV) - position(o, axisV);
+        return (ax * by - ay * bx) * orientation;
+    };
+
+    std::vector<uint32_t> remaining(count);
+    for (uint32_t i = 0; i < count; i++) remaining[i] = i;
+
+    while (remaining.size() > 3 && normal[dropAxis] != 0.0f) {
+        const size_t m = remaining.size();
+        bool clipped = false;
+        // 从 1 开始找耳朵：凸多边形时结果就是以 0 号顶点为中心的扇形
+        for (size_t step = 0; step < m && !clipped; step++) {
+            size_t i = (step + 1) % m;
+            const Index& prev = corners[remaining[(i + m - 1) % m]];
+            const Index& cur = corners[remaining[i]];
+            const Index& next = corners[remaining[(i + 1) % m]];
+            if (cross2(prev, cur, next) <= 0.0f) continue; // 凹角或退化
+
+            bool containsPoint = false;
+            for (size_t k = 0; k < m && !containsPoint; k++) {
+                if (k == i || k == (i + m - 1) % m || k == (i + 1) % m) continue;
+                const Index& p = corners[remaining[k]];
+                containsPoint = cross2(prev, cur, p) >= 0.0f && cross2(cur, next, p) >= 0.0f &&
+                                cross2(next, prev, p) >= 0.0f;
+            }
+            if (containsPoint) continue;
+
+            emitTriangle(chunk, prev, cur, next, material);
+            remaining.erase(remaining.begin() + static_cast<long>(i));
+            clipped = true;
+        }
+        if (!clipped) break; // 自相交等异常输入：剩余部分退化为扇形
+    }
+
+    for (size_t i = 1; i + 1 < remaining.size(); i++) {
+        emitTriangle(chunk, corners[remaining[0]], corners[remaining[i]], corners[remaining[i + 1]], material);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// MTL
+// ---------------------------------------------------------------------------
+// 贴图行可能带 -bm / -s 等选项，文件名取最后一个字段
+std::string textureName(const char* p, const char* end) {
+    std::string rest = restOfLine(p, end);
+    size_t split = rest.find_last_of(" \t");
+    return split == std::string::npos ? rest : rest.substr(split + 1);
+}
+
+} // namespace
+
+bool parseMaterialFile(const std::string& filename, std::vector<Material>& materials) {
+    MappedFile file;
+    if (!file.open(filename)) return false;
+
+    const char* data = reinterpret_cast<const char*>(file.getData());
+    const char* end = data + file.getSize();
+    Material* current = nullptr;
+
+    for (const char* line = data; line < end;) {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        const char* lineEnd = newline ? newline : end;
+        const char* p = skipSpaces(line, lineEnd);
+
+        if (keywordIs(p, lineEnd, "newmtl")) {
+            materials.emplace_back();
+            current = &materials.back();
+            current->name = restOfLine(p + 6, lineEnd);
+        } else if (current && keywordIs(p, lineEnd, "Kd")) {
+            const char* q = p + 2;
+            for (float& c : current->diffuse) {
+                const char* r = scanFloat(q, lineEnd, c);
+                if (!r) break;
+                q = r;
+            }
+        } else if (current && keywordIs(p, lineEnd, "map_Kd")) {
+            current->diffuseTexname = textureName(p + 6, lineEnd);
+        } else if (current && keywordIs(p, lineEnd, "map_Ks")) {
+            current->specularTexname = textureName(p + 6, lineEnd);
+        }
+
+        line = newline ? newline + 1 : end;
+    }
+    return true;
+}
+
+bool parseFile(const std::string& filename, const std::string& mtlSearchPath,
+               Mesh& mesh, std::string& error, std::string& warning) {
+    mesh = Mesh();
+
+    MappedFile file;
+    if (!file.open(filename)) {
+        error = "Cannot open file: " + filename;
+        return false;
+    }
+    const char* data = reinterpret_cast<const char*>(file.getData());
+    const size_t size = file.getSize();
+
+    // 1. 按行边界切块
+    // 在线程池里被调用时 (异步加载) 只用当前线程：池本身已经按核心数并行解析多个文件
+    size_t threadCount = ThreadPool::isWorkerThread() ? 1 : std::max(1u, std::thread::hardware_concurrency());
+    size_t chunkCount = std::max<size_t>(1, std::min(threadCount, size / kMinChunkBytes));
+
+    std::vector<const char*> bounds;
+    bounds.push_back(data);
+    for (size_t i = 1; i < chunkCount; i++) {
+        const char* split = data + size * i / chunkCount;
+        if (split < bounds.back()) split = bounds.back();
+        const char* newline = static_cast<const char*>(std::memchr(split, '\n', static_cast<size_t>(data + size - split)));
+        if (!newline) break;
+        bounds.push_back(newline + 1);
+    }
+    bounds.push_back(data + size);
+    chunkCount = bounds.size() - 1;
+
+    std::vector<Chunk> chunks(chunkCount);
+
+    auto runParallel = [chunkCount](auto&& job) {
+        if (chunkCount == 1) {
+            job(0);
+            return;
+        }
+        std::vector<std::thread> workers;
+        workers.reserve(chunkCount - 1);
+        for (size_t i = 1; i < chunkCount; i++) workers.emplace_back(job, i);
+        job(0); // 当前线程处理第一块
+        for (auto& worker : workers) worker.join();
+    };
+
+    // 2. 并行解析
+    runParallel([&](size_t i) { parseChunk(bounds[i], bounds[i + 1], chunks[i]); });
+
+    for (const auto& chunk : chunks) {
+        if (!chunk.error.empty()) {
+            error = chunk.error;
+            return false;
+        }
+    }
+
+    // 3. 合并顶点属性，并把相对索引修正为全局索引
+    size_t vBase = 0, vtBase = 0, vnBase = 0;
+    std::vector<size_t> vBases(chunkCount), vtBases(chunkCount), vnBases(chunkCount);
+    for (size_t i = 0; i < chunkCount; i++) {
+        vBases[i] = vBase;
+        vtBases[i] = vtBase;
+        vnBases[i] = vnBase;
+        vBase += chunks[i].positions.size() / 3;
+        vtBase += chunks[i].texcoords.size() / 2;
+        vnBase += chunks[i].normals.size() / 3;
+    }
+
+    mesh.positions.reserve(vBase * 3);
+    mesh.texcoords.reserve(vtBase * 2);
+    mesh.normals.reserve(vnBase * 3);
+    for (const auto& chunk : chunks) {
+        mesh.positions.insert(mesh.positions.end(), chunk.positions.begin(), chunk.positions.end());
+        mesh.texcoords.insert(mesh.texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+        mesh.normals.insert(mesh.normals.end(), chunk.normals.begin(), chunk.normals.end());
+    }
+
+    for (size_t i = 0; i < chunkCount; i++) {
+        Chunk& chunk = chunks[i];
+        for (size_t c = 0; c < chunk.corners.size(); c++) {
+            Index& index = chunk.corners[c];
+            const uint8_t mask = chunk.relative[c];
+            if (mask & kRelativeVertex) index.vertex += static_cast<int>(vBases[i]);
+            if (mask & kRelativeTexcoord) index.texcoord += static_cast<int>(vtBases[i]);
+            if (mask & kRelativeNormal) index.normal += static_cast<int>(vnBases[i]);
+
+            if (index.vertex < 0 || static_cast<size_t>(index.vertex) >= vBase) {
+                error = "Vertex index out of range in " + filename;
+                return false;
+            }
+            if (index.texcoord == kMissing) {
+                index.texcoord = -1;
+            } else if (index.texcoord < 0 || static_cast<size_t>(index.texcoord) >= vtBase) {
+                error = "Texcoord index out of range in " + filename;
+                return false;
+            }
+            if (index.normal == kMissing) {
+                index.normal = -1;
+            } else if (index.normal < 0 || static_cast<size_t>(index.normal) >= vnBase) {
+                error = "Normal index out of range in " + filename;
+                return false;
+            }
+        }
+    }
+
+    // 4. 材质库 (按出现顺序，同名文件只加载一次)
+    std::unordered_set<std::string> loadedLibs;
+    std::ostringstream warnings;
+    for (const auto& chunk : chunks) {
+        for (const auto& line : chunk.materialLibs) {
+            if (!loadedLibs.insert(line).second) continue;
+
+            // 一行可以列出多个文件，使用第一个能打开的
+            std::istringstream names(line);
+            std::string name;
+            bool loaded = false;
+            while (!loaded && names >> name) {
+                std::string path = mtlSearchPath.empty() ? name : mtlSearchPath + "/" + name;
+                loaded = parseMaterialFile(path, mesh.materials);
+            }
+            if (!loaded) warnings << "Material file [ " << line << " ] not found.\n";
+        }
+    }
+
+    std::unordered_map<std::string, int> materialIds;
+    for (size_t m = 0; m < mesh.materials.size(); m++) {
+        materialIds[mesh.materials[m].name] = static_cast<int>(m); // 同名时后者覆盖前者
+    }
+
+    std::unordered_set<std::string> missingMaterials;
+    auto resolveMaterial = [&](const std::string& name) {
+        auto it = materialIds.find(name);
+        if (it != materialIds.end()) return it->second;
+        if (missingMaterials.insert(name).second) {
+            warnings << "material [ '" << name << "' ] not found in .mtl\n";
+        }
+        return -1;
+    };
+
+    // 每块的材质槽 -> 全局材质 ID；没有 usemtl 的开头部分沿用上一块末尾的材质
+    std::vector<std::vector<int>> slotIds(chunkCount);
+    std::vector<int> inheritedMaterial(chunkCount, -1);
+    int carried = -1;
+    for (size_t i = 0; i < chunkCount; i++) {
+        inheritedMaterial[i] = carried;
+        for (const auto& name : chunks[i].materialNames) slotIds[i].push_back(resolveMaterial(name));
+        if (chunks[i].lastSlot >= 0) carried = slotIds[i][chunks[i].lastSlot];
+    }
+
+    // 5. 并行三角化
+    runParallel([&](size_t i) {
+        Chunk& chunk = chunks[i];
+        chunk.triangles.reserve(chunk.corners.size() * 2);
+        for (const Polygon& polygon : chunk.polygons) {
+            int material = polygon.materialSlot >= 0 ? slotIds[i][polygon.materialSlot] : inheritedMaterial[i];
+            triangulatePolygon(chunk, &chunk.corners[polygon.firstCorner], polygon.cornerCount, material,
+                               mesh.positions);
+        }
+    });
+
+    size_t triangleCount = 0;
+    for (const auto& chunk : chunks) triangleCount += chunk.triangleMaterials.size();
+    mesh.indices.reserve(triangleCount * 3);
+    mesh.materialIds.reserve(triangleCount);
+    for (const auto& chunk : chunks) {
+        mesh.indices.insert(mesh.indices.end(), chunk.triangles.begin(), chunk.triangles.end());
+        mesh.materialIds.insert(mesh.materialIds.end(), chunk.triangleMaterials.begin(), chunk.triangleMaterials.end());
+    }
+
+    warning = warnings.str();
+    return true;
+}
+
+} // namespace ObjParser
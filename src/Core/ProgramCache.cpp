@@ -0,0 +1,135 @@
+#include "Core/ProgramCache.h"
+#include "Core/GLExtensions.h"
+#include "Core/GLState.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace ProgramCache {
+
+// 64 位 FNV-1a，逐段累加
+static uint64_t hashBytes(const void *data, size_t size, uint64_t hash)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t hashString(const char *text, uint64_t hash)
+{
+    // 把结尾的 0 也算进去，避免 "ab" + "c" 和 "a" + "bc" 撞在一起
+    return text ? hashBytes(text, std::strlen(text) + 1, hash) : hashBytes("", 1, hash);
+}
+
+static std::string getCachePath(uint64_t key)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return std::string(DIRECTORY) + "/" + name;
+}
+
+uint64_t makeKey(const std::vector<std::string> &sources)
+{
+    uint64_t hash = 14695981039346656037ull;
+    hash = hashBytes(&VERSION, sizeof(VERSION), hash);
+    hash = hashString(reinterpret_cast<const char *>(glGetString(GL_VENDOR)), hash);
+    hash = hashString(reinterpret_cast<const char *>(glGetString(GL_RENDERER)), hash);
+    hash = hashString(reinterpret_cast<const char *>(glGetString(GL_VERSION)), hash);
+    for (const std::string &source : sources) hash = hashString(source.c_str(), hash);
+    return hash;
+}
+
+GLuint load(uint64_t key)
+{
+    const GLExtensions::ProgramBinaryApi *api = GLExtensions::getProgramBinaryApi();
+    if (!api) return 0;
+
+    std::string path = getCachePath(key);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return 0;
+
+    Header header{};
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    bool valid = in && std::memcmp(header.magic, MAGIC, sizeof(header.magic)) == 0 &&
+                 header.version == VERSION && header.key == key && header.length > 0;
+    std::vector<char> binary;
+    if (valid) {
+        binary.resize(header.length);
+        in.read(binary.data(), header.length);
+        valid = static_cast<bool>(in);
+    }
+    in.close();
+
+    GLuint program = 0;
+    if (valid) {
+        program = glCreateProgram();
+        api->programBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(header.length));
+        GLint success = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success) {
+            // 驱动更新后格式不再兼容等情况：丢掉这份缓存，重新编译
+            GLState::deleteProgram(program);
+            program = 0;
+        }
+    }
+
+    if (!program) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return 0;
+    }
+
+#ifndef NDEBUG
+    std::cout << "[Shader] Program cache hit: " << path << std::endl;
+#endif
+    return program;
+}
+
+void prepare(GLuint program)
+{
+    const GLExtensions::ProgramBinaryApi *api = GLExtensions::getProgramBinaryApi();
+    if (api) api->programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+bool store(uint64_t key, GLuint program)
+{
+    const GLExtensions::ProgramBinaryApi *api = GLExtensions::getProgramBinaryApi();
+    if (!api) return false;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return false;
+
+    std::vector<char> binary(length);
+    GLsizei written = 0;
+    GLenum format = 0;
+    api->getProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return false;
+
+    std::error_code ec;
+    std::filesystem::create_directories(DIRECTORY, ec);
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.key = key;
+    header.binaryFormat = format;
+    header.length = static_cast<uint32_t>(written);
+
+    std::string path = getCachePath(key);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cout << "[Shader] Warning: failed to write program cache " << path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(binary.data(), written);
+    return static_cast<bool>(out);
+}
+
+} // namespace ProgramCache
@@ -0,0 +1,321 @@
+#include "Core/QuadMerger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace QuadMerger {
+namespace {
+
+// 两个方向视为平行 / 垂直的阈值 (导出工具的浮点噪声在 1e-6 量级)
+constexpr float kParallel = 0.999f;
+constexpr float kPerpendicular = 0.001f;
+// 平面距离、网格坐标的合并容差 (相对于包围盒对角线)
+constexpr float kRelativeTolerance = 1e-4f;
+
+// 单个平面的网格单元数上限，超过时该平面不处理 (避免退化输入占用大量内存)
+constexpr size_t kMaxPlaneCells = 1 << 20;
+
+struct AlignedTriangle {
+    uint32_t triangle;
+    int axis;     // 0..2，所在平面的法线轴
+    int sign;     // +1 / -1
+    float offset; // 平面到原点的距离 (沿 axis)
+    glm::vec3 color;
+};
+
+// 平面内同一朝向、同一颜色的三角形集合
+struct Label {
+    int sign;
+    glm::vec3 color;
+    std::vector<uint8_t> filled; // 每个网格单元是否被覆盖
+    float triangleArea;
+    bool valid;
+};
+
+// 按容差把一组坐标聚类，返回升序的代表值
+std::vector<float> clusterValues(std::vector<float> values, float tolerance) {
+    std::sort(values.begin(), values.end());
+    std::vector<float> clusters;
+    for (float v : values) {
+        if (clusters.empty() || v - clusters.back() > tolerance) clusters.push_back(v);
+    }
+    return clusters;
+}
+
+int findCluster(const std::vector<float>& clusters, float value, float tolerance) {
+    auto it = std::lower_bound(clusters.begin(), clusters.end(), value - tolerance);
+    return static_cast<int>(it - clusters.begin());
+}
+
+// 点是否在三角形内 (含边界)，二维
+bool insideTriangle(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b, const glm::vec2& c) {
+    auto edge = [](const glm::vec2& o, const glm::vec2& x, const glm::vec2& y) {
+        return (x.x - o.x) * (y.y - o.y) - (x.y - o.y) * (y.x - o.x);
+    };
+    float d0 = edge(a, b, p), d1 = edge(b, c, p), d2 = edge(c, a, p);
+    bool hasNeg = d0 < 0 || d1 < 0 || d2 < 0;
+    bool hasPos = d0 > 0 || d1 > 0 || d2 > 0;
+    return !(hasNeg && hasPos);
+}
+
+} // namespace
+
+bool mergeCoplanarQuads(std::vector<glm::vec3>& positions,
+                        std::vector<glm::vec3>& normals,
+                        std::vector<glm::vec2>& texcoords,
+                        std::vector<glm::vec3>& colors,
+                        std::vector<unsigned int>& indices) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) return false;
+
+    glm::vec3 minP(1e30f), maxP(-1e30f);
+    for (const auto& p : positions) {
+        minP = glm::min(minP, p);
+        maxP = glm::max(maxP, p);
+    }
+    const float tolerance = glm::length(maxP - minP) * kRelativeTolerance;
+    if (tolerance <= 0.0f) return false;
+
+    // 1. 找出模型的正交坐标系：第一个法线为轴 0，第一个与之垂直的法线为轴 1
+    glm::vec3 axes[3];
+    int axisCount = 0;
+    std::vector<glm::vec3> faceNormals(triangleCount, glm::vec3(0.0f));
+    for (size_t t = 0; t < triangleCount; t++) {
+        const glm::vec3& a = positions[indices[t * 3]];
+        const glm::vec3& b = positions[indices[t * 3 + 1]];
+        const glm::vec3& c = positions[indices[t * 3 + 2]];
+        glm::vec3 n = glm::cross(b - a, c - a);
+        float len = glm::length(n);
+        if (len <= 0.0f) continue;
+        n /= len;
+        faceNormals[t] = n;
+
+        if (axisCount == 0) {
+            axes[0] = n;
+            axisCount = 1;
+        } else if (axisCount == 1 && std::fabs(glm::dot(n, axes[0])) < kPerpendicular) {
+            axes[1] = n;
+            axes[2] = glm::normalize(glm::cross(axes[0], axes[1]));
+            axisCount = 3;
+        }
+    }
+    if (axisCount == 0) return false;
+    if (axisCount == 1) {
+        // 整个模型只有一个朝向 (单面片)，随便补两条垂直轴
+        glm::vec3 helper = std::fabs(axes[0].x) < 0.9f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+        axes[1] = glm::normalize(glm::cross(axes[0], helper));
+        axes[2] = glm::cross(axes[0], axes[1]);
+    }
+
+    // 2. 挑出轴对齐且是平面着色 (三个顶点法线都等于面法线) 的三角形
+    std::vector<AlignedTriangle> aligned;
+    std::vector<bool> consumed(triangleCount, false);
+    for (size_t t = 0; t < triangleCount; t++) {
+        const glm::vec3& n = faceNormals[t];
+        if (n == glm::vec3(0.0f)) continue;
+
+        int axis = -1;
+        for (int k = 0; k < 3 && axis < 0; k++) {
+            if (std::fabs(glm::dot(n, axes[k])) > kParallel) axis = k;
+        }
+        if (axis < 0) continue;
+        const int sign = glm::dot(n, axes[axis]) > 0.0f ? 1 : -1;
+
+        bool flat = true;
+        const glm::vec3& color = colors[indices[t * 3]];
+        for (int k = 0; k < 3 && flat; k++) {
+            unsigned int v = indices[t * 3 + k];
+            flat = glm::dot(normals[v], axes[axis] * float(sign)) > kParallel && colors[v] == color;
+        }
+        if (!flat) continue;
+
+        AlignedTriangle entry;
+        entry.triangle = static_cast<uint32_t>(t);
+        entry.axis = axis;
+        entry.sign = sign;
+        entry.offset = glm::dot(positions[indices[t * 3]], axes[axis]);
+        entry.color = color;
+        aligned.push_back(entry);
+    }
+    if (aligned.size() < 2) return false;
+
+    // 3. 按 (轴, 平面距离) 排序，相邻且距离在容差内的归为同一平面
+    //    同一平面里两个朝向、所有颜色共用一张网格，方便找出背靠背的内部面
+    std::sort(aligned.begin(), aligned.end(), [](const AlignedTriangle& a, const AlignedTriangle& b) {
+        if (a.axis != b.axis) return a.axis < b.axis;
+        return a.offset < b.offset;
+    });
+
+    std::vector<unsigned int> merged;
+    const size_t originalVertexCount = positions.size();
+
+    size_t planeStart = 0;
+    while (planeStart < aligned.size()) {
+        const int axis = aligned[planeStart].axis;
+        size_t planeEnd = planeStart + 1;
+        while (planeEnd < aligned.size() && aligned[planeEnd].axis == axis &&
+               aligned[planeEnd].offset - aligned[planeEnd - 1].offset <= tolerance) {
+            planeEnd++;
+        }
+
+        // 4. 投影到平面二维坐标，坐标压缩成不规则网格
+        const glm::vec3& axisN = axes[axis];
+        const glm::vec3& axisU = axes[(axis + 1) % 3];
+        const glm::vec3& axisV = axes[(axis + 2) % 3];
+
+        std::vector<float> us, vs;
+        float offsetSum = 0.0f;
+        for (size_t i = planeStart; i < planeEnd; i++) {
+            const uint32_t t = aligned[i].triangle;
+            offsetSum += aligned[i].offset;
+            for (int k = 0; k < 3; k++) {
+                const glm::vec3& p = positions[indices[t * 3 + k]];
+                us.push_back(glm::dot(p, axisU));
+                vs.push_back(glm::dot(p, axisV));
+            }
+        }
+        const float planeOffset = offsetSum / float(planeEnd - planeStart);
+        std::vector<float> gridU = clusterValues(us, tolerance);
+        std::vector<float> gridV = clusterValues(vs, tolerance);
+        const size_t cellsU = gridU.size() - 1;
+        const size_t cellsV = gridV.size() - 1;
+        const size_t cellCount = cellsU * cellsV;
+        if (cellsU == 0 || cellsV == 0 || cellCount > kMaxPlaneCells) {
+            planeStart = planeEnd;
+            continue;
+        }
+
+        // 平面内按 (朝向, 颜色) 分成若干标签，每个标签一张覆盖图
+        std::vector<Label> labels;
+        std::vector<int> labelOf(planeEnd - planeStart);
+        for (size_t i = planeStart; i < planeEnd; i++) {
+            int found = -1;
+            for (size_t l = 0; l < labels.size() && found < 0; l++) {
+                if (labels[l].sign == aligned[i].sign && labels[l].color == aligned[i].color) found = int(l);
+            }
+            if (found < 0) {
+                found = static_cast<int>(labels.size());
+                labels.push_back({aligned[i].sign, aligned[i].color, std::vector<uint8_t>(cellCount, 0), 0.0f, true});
+            }
+            labelOf[i - planeStart] = found;
+        }
+
+        // 5. 光栅化：网格单元中心落在某个三角形内即视为被覆盖
+        //    (单元中心恰好落在四边形对角线上时会被两个三角形同时命中，所以面积用覆盖图统计)
+        for (size_t i = planeStart; i < planeEnd; i++) {
+            const uint32_t t = aligned[i].triangle;
+            Label& label = labels[labelOf[i - planeStart]];
+            glm::vec2 corner[3];
+            int minU = INT32_MAX, maxU = -1, minV = INT32_MAX, maxV = -1;
+            for (int k = 0; k < 3; k++) {
+                const glm::vec3& p = positions[indices[t * 3 + k]];
+                int cu = findCluster(gridU, glm::dot(p, axisU), tolerance);
+                int cv = findCluster(gridV, glm::dot(p, axisV), tolerance);
+                corner[k] = glm::vec2(gridU[cu], gridV[cv]);
+                minU = std::min(minU, cu); maxU = std::max(maxU, cu);
+                minV = std::min(minV, cv); maxV = std::max(maxV, cv);
+            }
+            glm::vec2 e1 = corner[1] - corner[0], e2 = corner[2] - corner[0];
+            label.triangleArea += std::fabs(e1.x * e2.y - e1.y * e2.x) * 0.5f;
+
+            for (int cv = minV; cv < maxV; cv++) {
+                for (int cu = minU; cu < maxU; cu++) {
+                    glm::vec2 center((gridU[cu] + gridU[cu + 1]) * 0.5f, (gridV[cv] + gridV[cv + 1]) * 0.5f);
+                    if (insideTriangle(center, corner[0], corner[1], corner[2])) label.filled[cv * cellsU + cu] = 1;
+                }
+            }
+        }
+
+        // 覆盖面积必须与三角形面积之和一致，否则说明有斜边或重叠，该标签放弃合并
+        for (auto& label : labels) {
+            float cellArea = 0.0f;
+            for (size_t cv = 0; cv < cellsV; cv++) {
+                for (size_t cu = 0; cu < cellsU; cu++) {
+                    if (label.filled[cv * cellsU + cu]) cellArea += (gridU[cu + 1] - gridU[cu]) * (gridV[cv + 1] - gridV[cv]);
+                }
+            }
+            label.valid = std::fabs(cellArea - label.triangleArea) <= std::max(label.triangleArea, 1e-12f) * 1e-3f;
+        }
+
+        // 相邻方块之间背靠背的两个面都看不见，同时删掉
+        for (size_t cell = 0; cell < cellCount; cell++) {
+            bool front = false, back = false;
+            for (const auto& label : labels) {
+                if (!label.valid || !label.filled[cell]) continue;
+                (label.sign > 0 ? front : back) = true;
+            }
+            if (!front || !back) continue;
+            for (auto& label : labels) {
+                if (label.valid) label.filled[cell] = 0;
+            }
+        }
+
+        for (size_t i = planeStart; i < planeEnd; i++) {
+            if (labels[labelOf[i - planeStart]].valid) consumed[aligned[i].triangle] = true;
+        }
+
+        // 6. 贪心合并：先沿 U 方向尽量延伸，再整行沿 V 方向延伸
+        for (auto& label : labels) {
+            if (!label.valid) continue;
+            const glm::vec3 normal = axisN * float(label.sign);
+            std::vector<uint8_t>& filled = label.filled;
+            for (size_t cv = 0; cv < cellsV; cv++) {
+                for (size_t cu = 0; cu < cellsU; cu++) {
+                    if (!filled[cv * cellsU + cu]) continue;
+
+                    size_t width = 1;
+                    while (cu + width < cellsU && filled[cv * cellsU + cu + width]) width++;
+
+                    size_t height = 1;
+                    while (cv + height < cellsV) {
+                        bool rowOk = true;
+                        for (size_t x = cu; x < cu + width && rowOk; x++) rowOk = filled[(cv + height) * cellsU + x] != 0;
+                        if (!rowOk) break;
+                        height++;
+                    }
+
+                    // 已输出的单元清零，避免重复使用
+                    for (size_t y = cv; y < cv + height; y++)
+                        for (size_t x = cu; x < cu + width; x++) filled[y * cellsU + x] = 0;
+
+                    // 输出矩形：U x V = N，所以 (u0,v0) -> (u1,v0) -> (u1,v1) 是绕 +N 逆时针
+                    const float u0 = gridU[cu], u1 = gridU[cu + width];
+                    const float v0 = gridV[cv], v1 = gridV[cv + height];
+                    const unsigned int base = static_cast<unsigned int>(positions.size());
+                    const float cornerUV[4][2] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+                    for (const auto& uv : cornerUV) {
+                        positions.push_back(axisN * planeOffset + axisU * uv[0] + axisV * uv[1]);
+                        normals.push_back(normal);
+                        texcoords.push_back(glm::vec2(0.0f));
+                        colors.push_back(label.color);
+                    }
+                    if (label.sign > 0) {
+                        merged.insert(merged.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+                    } else {
+                        merged.insert(merged.end(), {base, base + 2, base + 1, base, base + 3, base + 2});
+                    }
+                }
+            }
+        }
+
+        planeStart = planeEnd;
+    }
+
+    // 7. 未参与合并的三角形原样保留
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (consumed[t]) continue;
+        merged.insert(merged.end(), {indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2]});
+    }
+
+    if (merged.size() >= indices.size()) {
+        positions.resize(originalVertexCount);
+        normals.resize(originalVertexCount);
+        texcoords.resize(originalVertexCount);
+        colors.resize(originalVertexCount);
+        return false;
+    }
+    indices.swap(merged);
+    return true;
+}
+
+} // namespace QuadMerger
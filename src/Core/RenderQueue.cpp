@@ -0,0 +1,132 @@
+#include "Core/RenderQueue.h"
+#include "Core/GLState.h"
+#include <algorithm>
+
+// lighting_fs 的阴影开关 (默认为 true)
+static constexpr Uniform<bool> U_RECEIVE_SHADOWS("receiveShadows");
+static constexpr Uniform<glm::mat4> U_MODEL("model");
+
+static const int PROGRAM_BITS = 12;
+static const int MATERIAL_BITS = 16;
+static const int VAO_BITS = 12;
+static const int DEPTH_BITS = 20;
+
+void RenderQueue::begin(const glm::vec3& position, float distanceLimit) {
+    packets.clear();
+    keys.clear();
+    cameraPos = position;
+    maxDistance = distanceLimit;
+}
+
+uint64_t RenderQueue::makeKey(Pass pass, const Shader& shader, const TriMesh& mesh, float distance) {
+    auto it = programIds.find(&shader);
+    if (it == programIds.end())
+        it = programIds.emplace(&shader, static_cast<uint32_t>(programIds.size())).first;
+
+    const uint64_t depthMax = (1u << DEPTH_BITS) - 1;
+    float normalized = std::min(std::max(distance / maxDistance, 0.0f), 1.0f);
+    uint64_t depth = static_cast<uint64_t>(normalized * depthMax);
+
+    uint64_t key = static_cast<uint64_t>(pass) << (PROGRAM_BITS + MATERIAL_BITS + VAO_BITS + DEPTH_BITS);
+    key |= static_cast<uint64_t>(it->second & ((1u << PROGRAM_BITS) - 1)) << (MATERIAL_BITS + VAO_BITS + DEPTH_BITS);
+    key |= static_cast<uint64_t>(mesh.getMaterialKey()) << (VAO_BITS + DEPTH_BITS);
+    key |= static_cast<uint64_t>(mesh.getVertexArray() & ((1u << VAO_BITS) - 1)) << DEPTH_BITS;
+    key |= depth;
+    return key;
+}
+
+void RenderQueue::push(uint64_t key, const Packet& packet) {
+    keys.push_back(key);
+    packets.push_back(packet);
+}
+
+void RenderQueue::draw(Pass pass, const Shader& shader, const TriMesh& mesh, const glm::mat4& model, int lod) {
+    float distance = glm::length(glm::vec3(model[3]) - cameraPos);
+    push(makeKey(pass, shader, mesh, distance), {&shader, &mesh, lod, model, 0, 0, 0, true});
+}
+
+void RenderQueue::drawInstanced(Pass pass, const Shader& shader, const TriMesh& mesh, GLuint instanceBuffer,
+                                GLsizei firstInstance, GLsizei count, int lod, float distance,
+                                bool receiveShadows) {
+    if (count <= 0) return;
+    push(makeKey(pass, shader, mesh, distance),
+         {&shader, &mesh, lod, glm::mat4(1.0f), instanceBuffer, firstInstance, count, receiveShadows});
+}
+
+void RenderQueue::radixSort() {
+    const size_t count = keys.size();
+    order.resize(count);
+    for (size_t i = 0; i < count; i++) order[i] = static_cast<uint32_t>(i);
+    sortedOrder.resize(count);
+    sortedKeys.resize(count);
+
+    // 只排 keys 和下标，packets 保持插入顺序，提交时按 order 间接访问
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+        for (size_t i = 0; i < count; i++) histogram[(keys[i] >> shift) & 0xFF]++;
+        // 所有键在这个字节上都相同，这一趟不改变顺序
+        if (histogram[(keys[0] >> shift) & 0xFF] == count) continue;
+
+        size_t offset = 0;
+        for (size_t& bucket : histogram) {
+            size_t n = bucket;
+            bucket = offset;
+            offset += n;
+        }
+        // 计数排序是稳定的：键相同的绘制保持提交顺序
+        for (size_t i = 0; i < count; i++) {
+            size_t slot = histogram[(keys[i] >> shift) & 0xFF]++;
+            sortedKeys[slot] = keys[i];
+            sortedOrder[slot] = order[i];
+        }
+        keys.swap(sortedKeys);
+        order.swap(sortedOrder);
+    }
+}
+
+void RenderQueue::submit() {
+    stats = Stats();
+    stats.packets = packets.size();
+    if (packets.empty()) return;
+
+    radixSort();
+
+    const Shader* currentShader = nullptr;
+    const TriMesh* currentMaterial = nullptr;
+    GLuint currentVao = 0;
+    for (uint32_t index : order) {
+        const Packet& packet = packets[index];
+
+        if (packet.shader != currentShader) {
+            packet.shader->use();
+            currentShader = packet.shader;
+            // 采样器编号是程序的 uniform，换程序后材质要重新设置
+            currentMaterial = nullptr;
+            stats.programBinds++;
+        }
+        if (!currentMaterial || !packet.mesh->sharesMaterial(*currentMaterial)) {
+            packet.mesh->bindMaterial(*packet.shader);
+            currentMaterial = packet.mesh;
+            stats.materialBinds++;
+        }
+        GLuint vao = packet.mesh->getVertexArray();
+        if (vao != currentVao) {
+            GLState::bindVertexArray(vao);
+            currentVao = vao;
+            stats.vaoBinds++;
+        }
+
+        if (!packet.receiveShadows) packet.shader->set(U_RECEIVE_SHADOWS, false);
+        if (packet.instanceCount > 0) {
+            packet.mesh->bindInstanceAttributes(packet.instanceBuffer, packet.firstInstance);
+            packet.mesh->drawLod(packet.lod, packet.instanceCount);
+        } else {
+            packet.shader->set(U_MODEL, packet.model);
+            packet.mesh->drawLod(packet.lod);
+        }
+        if (!packet.receiveShadows) packet.shader->set(U_RECEIVE_SHADOWS, true);
+    }
+
+    packets.clear();
+    keys.clear();
+}
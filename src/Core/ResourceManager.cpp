@@ -1,6 +1,76 @@
 #include "Core/ResourceManager.h"
+#include "Core/MappedFile.h"
+#include "Core/MeshFile.h"
+#include "Core/TextureLoader.h"
+#include "Core/GLState.h"
+#include <filesystem>
+#include <iomanip>
 
-std::shared_ptr<TriMesh> ResourceManager::getMesh(const std::string& path) {
+// 白图在缓存里使用的键 (不会和真实文件路径冲突)
+static const char *WHITE_TEXTURE_KEY = "internal_white";
+
+// 规范化路径，保证 "a/./b.png" 与 "a/b.png" 命中同一项
+static std::string normalizeTexturePath(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+// 创建纹理对象并设置采样参数 (数据稍后上传)
+static GLuint createTextureObject() {
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    GLState::bindTexture(GL_TEXTURE_2D, textureID);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    // Minecraft 风格使用 GL_NEAREST (邻近采样) 保持像素颗粒感
+    // 如果要平滑效果则使用 GL_LINEAR_MIPMAP_LINEAR
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    return textureID;
+}
+
+// 把准备好的图片 (烘焙的 .stex 或解码后的源图片) 同步上传成 GL 纹理，失败返回 nullptr
+static std::shared_ptr<Texture2D> createTexture(const TextureLoader::PreparedImage& image) {
+    GLuint textureID = createTextureObject();
+
+    // 预生成的 mip 链逐级上传，不再在运行时 glGenerateMipmap
+    TextureLoader::Info info;
+    if (!TextureLoader::uploadPrepared(image, GL_TEXTURE_2D, info)) {
+        std::cerr << "Texture failed to load at path: " << image.sourcePath << std::endl;
+        GLState::deleteTextures(1, &textureID);
+        return nullptr;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, info.levelCount - 1);
+
+    auto texture = std::make_shared<Texture2D>(textureID, info.width, info.height, info.byteSize);
+    texture->setHasAlpha(image.hasAlpha);
+    return texture;
+}
+
+// 工作线程：优先映射烘焙好的二进制网格，失败则回退到 OBJ 解析，并顺手烘焙一份供下次启动使用
+// 这里不能调用任何 GL 函数，也不能访问 ResourceManager 的成员
+static void loadMeshData(TriMesh& mesh, const std::string& path) {
+    std::string cookedPath = MeshFile::getCookedPath(path);
+
+    if (isCookedFresh(cookedPath, path) && mesh.mapCooked(cookedPath)) {
+#ifndef NDEBUG
+        std::cout << "[Resource] Loading Cooked Model: " << cookedPath << std::endl;
+#endif
+        return;
+    }
+
+#ifndef NDEBUG
+    std::cout << "[Resource] Loading New Model: " << path << std::endl;
+#endif
+    mesh.parseObj(path);
+    if (!mesh.saveCooked(cookedPath)) {
+        std::cout << "[Resource] Warning: failed to write cooked mesh " << cookedPath << std::endl;
+    }
+}
+
+std::shared_ptr<TriMesh> ResourceManager::getMesh(const std::string& path, VertexFormat format,
+                                                  bool mergeCoplanarQuads, MeshRetention retention) {
     // 1. 先查表
     auto it = meshes.find(path);
     if (it != meshes.end()) {
@@ -10,19 +80,220 @@ std::shared_ptr<TriMesh> ResourceManager::getMesh(const std::string& path) {
         return it->second;
     }
 
-    // 2. 如果没找到，加载新模型
+    // 2. 如果没找到，加载新模型 (已经在后台加载的会合并到同一个任务)
+    return waitForMesh(getMeshAsync(path, format, mergeCoplanarQuads, retention));
+}
+
+MeshHandle ResourceManager::getMeshAsync(const std::string& path, VertexFormat format,
+                                         bool mergeCoplanarQuads, MeshRetention retention) {
+    auto state = std::make_shared<MeshHandle::State>();
+    state->path = path;
+
+    // 1. 已经加载完成
+    auto it = meshes.find(path);
+    if (it != meshes.end()) {
+        state->mesh = it->second;
+        state->ready = true;
+        return MeshHandle(state);
+    }
+
+    // 2. 正在加载：合并请求
+    auto pending = pendingMeshes.find(path);
+    if (pending != pendingMeshes.end()) {
+        return MeshHandle(pending->second);
+    }
+
+    // 3. 新任务
+    // format / mergeCoplanarQuads / retention 只在首次加载时生效 (同一路径共享同一份 GPU 数据)
+    state->mesh = std::make_shared<TriMesh>();
+    state->mesh->setVertexFormat(format);
+    state->mesh->setMergeCoplanarQuads(mergeCoplanarQuads);
+    state->mesh->setRetention(retention);
+
+    if (!meshPool) meshPool = std::make_unique<ThreadPool>();
+    std::shared_ptr<TriMesh> mesh = state->mesh;
+    state->cpuJob = meshPool->submit([mesh, path]() { loadMeshData(*mesh, path); });
+
+    pendingMeshes[path] = state;
+    return MeshHandle(state);
+}
+
+std::shared_ptr<TriMesh> ResourceManager::waitForMesh(const MeshHandle& handle) {
+    if (!handle.isValid()) return nullptr;
+    if (!handle.state->ready) {
+        handle.state->cpuJob.wait();
+        finalizeMesh(handle.state);
+    }
+    return handle.state->mesh;
+}
+
+void ResourceManager::finalizeMesh(const std::shared_ptr<MeshHandle::State>& state) {
+    if (state->ready) return;
+    // 工作线程里的异常在这里重新抛出
+    state->cpuJob.get();
+
+    // 数据上传到 VBO/EBO 之后 (烘焙文件已经在工作线程写好)，CPU 端副本按保留策略释放
+    state->mesh->uploadToGpu();
+    state->mesh->releaseCpuData();
+
+    // 存入缓存
+    meshes[state->path] = state->mesh;
+    pendingMeshes.erase(state->path);
+    state->ready = true;
+}
+
+void ResourceManager::update() {
+    // 1. 已经解析完的模型：先把它们的贴图一起交给解码线程池，再逐个上传
+    std::vector<std::shared_ptr<MeshHandle::State>> finished;
+    for (const auto& entry : pendingMeshes) {
+        if (entry.second->cpuJob.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            finished.push_back(entry.second);
+        }
+    }
+    for (const auto& state : finished) {
+        prefetchTextures(state->mesh->getTexturePaths());
+    }
+    for (const auto& state : finished) {
+        finalizeMesh(state);
+    }
+
+    // 2. 流式纹理
+    streamer.update();
+}
+
+void ResourceManager::prefetchTextures(const std::vector<std::string>& paths) {
+    TextureLoader::Options options = TextureLoader::getDefaultOptions();
+    for (const auto& path : paths) {
+        std::string key = normalizeTexturePath(path);
+        if (pendingTextures.count(key)) continue;
+        auto it = textures.find(key);
+        if (it != textures.end() && !it->second.expired()) continue;
+
+        pendingTextures[key] = TextureLoader::prepareAsync(key, options);
+    }
+}
+
+std::shared_ptr<Texture2D> ResourceManager::getTexture(const std::string& path) {
+    std::string key = normalizeTexturePath(path);
+
+    auto it = textures.find(key);
+    if (it != textures.end()) {
+        if (auto texture = it->second.lock()) {
 #ifndef NDEBUG
-    std::cout << "[Resource] Loading New Model: " << path << std::endl;
+            std::cout << "[Resource] Texture Cache Hit: " << key << std::endl;
 #endif
-    std::shared_ptr<TriMesh> newMesh = std::make_shared<TriMesh>();
-    newMesh->readObjTiny(path);
+            return texture;
+        }
+    }
 
-    // 3. 存入缓存
-    meshes[path] = newMesh;
+#ifndef NDEBUG
+    std::cout << "[Texture Debug] Trying to load: " << key << std::endl;
+#endif
+    // 已经预取的直接等待结果，否则在当前线程同步准备
+    std::shared_ptr<Texture2D> texture;
+    auto pending = pendingTextures.find(key);
+    if (streamingEnabled) {
+        // 流式模式：立即返回一张占位 (白图) 纹理，解码与上传在之后的帧里完成
+        texture = std::make_shared<Texture2D>(createTextureObject(), 0, 0, 0);
+        texture->setPlaceholder(getWhiteTexture());
+        if (pending != pendingTextures.end()) {
+            streamer.enqueue(texture, std::move(pending->second));
+            pendingTextures.erase(pending);
+        } else {
+            streamer.enqueue(texture, TextureLoader::prepareAsync(key, TextureLoader::getDefaultOptions()));
+        }
+    } else if (pending != pendingTextures.end()) {
+        texture = createTexture(pending->second.get());
+        pendingTextures.erase(pending);
+    } else {
+        texture = createTexture(TextureLoader::prepare(key, TextureLoader::getDefaultOptions()));
+    }
+    if (texture) {
+        textures[key] = texture;
+    }
+    return texture;
+}
+
+std::shared_ptr<Texture2D> ResourceManager::getWhiteTexture() {
+    auto it = textures.find(WHITE_TEXTURE_KEY);
+    if (it != textures.end()) {
+        if (auto texture = it->second.lock()) return texture;
+    }
+
+    // 生成 1x1 白色纹理，用于给没有贴图的模型（如钻石剑）提供默认颜色乘数
+    unsigned char white[] = {255, 255, 255, 255}; // RGBA
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    GLState::bindTexture(GL_TEXTURE_2D, textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
 
-    return newMesh;
+    // 设置过滤参数，否则纹理可能无法采样
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    auto texture = std::make_shared<Texture2D>(textureID, 1, 1, sizeof(white));
+    textures[WHITE_TEXTURE_KEY] = texture;
+    return texture;
+}
+
+std::vector<MeshMemoryReport> ResourceManager::getMemoryReport() const {
+    std::vector<MeshMemoryReport> report;
+    report.reserve(meshes.size());
+    for (const auto& entry : meshes) {
+        report.push_back({entry.first, entry.second->getMemoryStats()});
+    }
+    return report;
+}
+
+void ResourceManager::printMemoryReport() const {
+    auto toKB = [](size_t bytes) { return bytes / 1024.0; };
+
+    size_t totalCpu = 0, totalGpu = 0;
+    std::ios oldState(nullptr);
+    oldState.copyfmt(std::cout);
+    std::cout << "[Resource] Memory report (KB):" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& line : getMemoryReport()) {
+        std::cout << "  CPU " << std::setw(9) << toKB(line.stats.cpuBytes)
+                  << " | GPU " << std::setw(9) << toKB(line.stats.gpuBytes)
+                  << " | " << line.path << std::endl;
+        totalCpu += line.stats.cpuBytes;
+        totalGpu += line.stats.gpuBytes;
+    }
+
+    // 纹理在网格之间共享，单独统计一次
+    size_t textureCount = 0;
+    for (const auto& entry : textures) {
+        if (auto texture = entry.second.lock()) {
+            std::cout << "  CPU " << std::setw(9) << 0.0
+                      << " | GPU " << std::setw(9) << toKB(texture->getByteSize())
+                      << " | " << entry.first << " (" << texture.use_count() - 1 << " refs)" << std::endl;
+            totalGpu += texture->getByteSize();
+            textureCount++;
+        }
+    }
+
+    std::cout << "  CPU " << std::setw(9) << toKB(totalCpu)
+              << " | GPU " << std::setw(9) << toKB(totalGpu)
+              << " | Total (" << meshes.size() << " meshes, " << textureCount << " textures)" << std::endl;
+    std::cout.copyfmt(oldState);
+}
+
+void ResourceManager::setTextureStreaming(bool enable) {
+    if (!enable) streamer.flush();
+    streamingEnabled = enable;
 }
 
 void ResourceManager::clear() {
+    // 后台任务全部完成后再清理 (工作线程持有模型的引用)
+    for (auto& entry : pendingMeshes) entry.second->cpuJob.wait();
+    pendingMeshes.clear();
+    streamer.flush();
     meshes.clear();
-}
\ No newline at end of file
+    // 等待还在解码的任务结束，避免工作线程写到已经释放的状态
+    for (auto& entry : pendingTextures) entry.second.wait();
+    pendingTextures.clear();
+    textures.clear();
+}
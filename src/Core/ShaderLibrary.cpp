@@ -0,0 +1,47 @@
+#include "Core/ShaderLibrary.h"
+#include <algorithm>
+
+std::shared_ptr<Shader> ShaderLibrary::get(const std::string& vertexPath, const std::string& fragmentPath,
+                                           const ShaderDefines& defines) {
+    std::shared_ptr<Shader> shader = request(vertexPath, fragmentPath, defines);
+    shader->finish();
+    return shader;
+}
+
+std::shared_ptr<Shader> ShaderLibrary::request(const std::string& vertexPath, const std::string& fragmentPath,
+                                               const ShaderDefines& defines) {
+    ShaderDefines sorted = defines;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::string key = vertexPath + '|' + fragmentPath;
+    for (const std::string& define : sorted) key += '|' + define;
+
+    auto it = programs.find(key);
+    if (it != programs.end()) return it->second;
+
+#ifndef NDEBUG
+    std::cout << "[Shader] Building permutation: " << key << std::endl;
+#endif
+    auto shader = std::make_shared<Shader>(vertexPath.c_str(), fragmentPath.c_str(), sorted,
+                                           ShaderCompileMode::Deferred);
+    programs[key] = shader;
+    return shader;
+}
+
+size_t ShaderLibrary::poll() {
+    size_t remaining = 0;
+    for (auto& entry : programs) {
+        Shader& shader = *entry.second;
+        if (shader.isReady()) continue;
+        if (shader.isCompileComplete())
+            shader.finish();
+        else
+            remaining++;
+    }
+    return remaining;
+}
+
+void ShaderLibrary::finishAll() {
+    for (auto& entry : programs) entry.second->finish();
+}
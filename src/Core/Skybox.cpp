@@ -1,18 +1,20 @@
 #include "Core/Skybox.h"
 #include <iostream>
-#include <stb_image.h>
+#include "Core/TextureLoader.h"
+#include "Core/ShaderLibrary.h"
+#include "Core/GLState.h"
 
 Skybox::Skybox() : dayTextureID(0), nightTextureID(0), VAO(0), VBO(0) {}
 
 Skybox::~Skybox() {
-    glDeleteVertexArrays(1, &VAO);
+    GLState::deleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
     // texture 删除略
 }
 
 void Skybox::init() {
-    // 1. 编译 Shader
-    skyboxShader = std::make_shared<Shader>("assets/shaders/skybox_vs.glsl", "assets/shaders/skybox_fs.glsl");
+    // 1. 提交 Shader 编译，驱动在加载立方体贴图期间编译，用之前再 finish
+    skyboxShader = ShaderLibrary::getInstance().request("assets/shaders/skybox_vs.glsl", "assets/shaders/skybox_fs.glsl");
 
     // 2. 设置立方体顶点 (仅仅是位置)
     float skyboxVertices[] = {
@@ -62,7 +64,7 @@ void Skybox::init() {
 
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
+    GLState::bindVertexArray(VAO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(skyboxVertices), &skyboxVertices, GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
@@ -77,11 +79,6 @@ void Skybox::init() {
         "assets/textures/skybox/day/pz.png",
         "assets/textures/skybox/day/nz.png"
     };
-#ifndef NDEBUG
-    std::cout << "[Skybox] Loading Day Texture..." << std::endl;
-#endif
-    dayTextureID = loadCubemap(dayFaces);
-
     std::vector<std::string> nightFaces {
         "assets/textures/skybox/night/px.png",
         "assets/textures/skybox/night/nx.png",
@@ -90,30 +87,39 @@ void Skybox::init() {
         "assets/textures/skybox/night/pz.png",
         "assets/textures/skybox/night/nz.png"
     };
+
+    // 12 张面先全部交给解码线程池，主线程再按顺序等待并上传
+    TextureLoader::Options options = TextureLoader::getDefaultOptions();
+    options.mipmaps = false; // 天空盒基本按 1:1 采样，不需要 mip 链
+    options.uniformFormat = true; // 六个面格式不一致时立方体贴图不完整，采样全黑
+    auto dayJobs = prepareFaces(dayFaces, options);
+    auto nightJobs = prepareFaces(nightFaces, options);
+
+#ifndef NDEBUG
+    std::cout << "[Skybox] Loading Day Texture..." << std::endl;
+#endif
+    dayTextureID = loadCubemap(dayFaces, dayJobs);
 #ifndef NDEBUG
     std::cout << "[Skybox] Loading Night Texture ..." << std::endl;
 #endif
-    nightTextureID = loadCubemap(nightFaces);
+    nightTextureID = loadCubemap(nightFaces, nightJobs);
     
     // 配置 shader 纹理单元
+    skyboxShader->finish();
     skyboxShader->use();
     skyboxShader->setInt("skybox", 0);
 }
 
-void Skybox::draw(const glm::mat4& view, const glm::mat4& projection, bool isNight) {
+void Skybox::draw(bool isNight) {
     // 1. 改变深度测试函数
     // 用 GL_LEQUAL，因为在 Shader 里把深度强制设为了 1.0
     // 这样天空盒就会画在所有物体的后面
-    glDepthFunc(GL_LEQUAL);
+    GLState::depthFunc(GL_LEQUAL);
     
     skyboxShader->use();
-    
-    // 2. 去掉 View 矩阵的平移部分
+
+    // 2. View/Proj 来自 FrameData UBO，去掉平移的工作放在了 skybox_vs 里
     // 天空盒不应该随玩家移动而移动，只随旋转而旋转
-    glm::mat4 viewNoTrans = glm::mat4(glm::mat3(view)); 
-    
-    skyboxShader->setMat4("view", viewNoTrans);
-    skyboxShader->setMat4("projection", projection);
 
     // 控制亮度
     if (isNight) {
@@ -125,40 +131,40 @@ void Skybox::draw(const glm::mat4& view, const glm::mat4& projection, bool isNig
     }
 
     // 3. 绑定贴图
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, isNight ? nightTextureID : dayTextureID);
+    GLState::bindTextureUnit(0, GL_TEXTURE_CUBE_MAP, isNight ? nightTextureID : dayTextureID);
 
     // 4. 绘制立方体
-    glBindVertexArray(VAO);
+    GLState::bindVertexArray(VAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
 
     // 5. 恢复深度测试函数
-    glDepthFunc(GL_LESS);
+    GLState::depthFunc(GL_LESS);
+}
+
+std::vector<std::future<TextureLoader::PreparedImage>> Skybox::prepareFaces(
+    const std::vector<std::string>& faces, const TextureLoader::Options& options) {
+    std::vector<std::future<TextureLoader::PreparedImage>> jobs;
+    jobs.reserve(faces.size());
+    for (const auto& face : faces) {
+        jobs.push_back(TextureLoader::prepareAsync(face, options));
+    }
+    return jobs;
 }
 
-unsigned int Skybox::loadCubemap(std::vector<std::string> faces) {
+unsigned int Skybox::loadCubemap(const std::vector<std::string>& faces,
+                                 std::vector<std::future<TextureLoader::PreparedImage>>& jobs) {
     unsigned int textureID;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    GLState::bindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 
-    int width, height, nrChannels;
+    // 每个面走烘焙纹理 (可能是块压缩格式)，解码已经在工作线程完成，这里只负责上传
     for (unsigned int i = 0; i < faces.size(); i++)
     {
-        unsigned char *data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
-        if (data)
-        {
-            // GL_TEXTURE_CUBE_MAP_POSITIVE_X 是起始枚举值，+i 依次对应右左上下前后
-            GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 
-                         0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data
-            );
-            stbi_image_free(data);
-        }
-        else
+        // GL_TEXTURE_CUBE_MAP_POSITIVE_X 是起始枚举值，+i 依次对应右左上下前后
+        TextureLoader::Info info;
+        if (!TextureLoader::uploadPrepared(jobs[i].get(), GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, info))
         {
             std::cout << "Cubemap texture failed to load at path: " << faces[i] << std::endl;
-            stbi_image_free(data);
         }
     }
     
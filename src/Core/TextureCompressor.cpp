@@ -0,0 +1,218 @@
+#include "Core/TextureCompressor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace TextureCompressor {
+
+namespace {
+
+// 取出一个 4x4 块 (越界时夹到边缘)
+void fetchBlock(const Image &image, int bx, int by, uint8_t block[16][4])
+{
+    for (int y = 0; y < 4; y++) {
+        int sy = std::min(by * 4 + y, image.height - 1);
+        for (int x = 0; x < 4; x++) {
+            int sx = std::min(bx * 4 + x, image.width - 1);
+            std::memcpy(block[y * 4 + x], &image.rgba[(size_t(sy) * image.width + sx) * 4], 4);
+        }
+    }
+}
+
+uint16_t packRGB565(const float color[3])
+{
+    int r = std::min(std::max(int(color[0] * 31.0f / 255.0f + 0.5f), 0), 31);
+    int g = std::min(std::max(int(color[1] * 63.0f / 255.0f + 0.5f), 0), 63);
+    int b = std::min(std::max(int(color[2] * 31.0f / 255.0f + 0.5f), 0), 31);
+    return uint16_t((r << 11) | (g << 5) | b);
+}
+
+void unpackRGB565(uint16_t packed, int color[3])
+{
+    int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// BC1 颜色块 (始终使用 4 色模式，BC3 的颜色部分也复用这里)
+void encodeColorBlock(const uint8_t block[16][4], uint8_t *out)
+{
+    // 1. 均值与协方差，幂迭代求主轴
+    float mean[3] = {0, 0, 0};
+    for (int i = 0; i < 16; i++)
+        for (int c = 0; c < 3; c++) mean[c] += block[i][c];
+    for (int c = 0; c < 3; c++) mean[c] /= 16.0f;
+
+    float cov[6] = {0, 0, 0, 0, 0, 0}; // xx xy xz yy yz zz
+    for (int i = 0; i < 16; i++) {
+        float d[3] = {block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2]};
+        cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+        cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+    }
+
+    float axis[3] = {1.0f, 1.0f, 1.0f};
+    for (int iter = 0; iter < 8; iter++) {
+        float next[3] = {
+            cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+            cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+            cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2],
+        };
+        float len = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+        if (len < 1e-6f) break;
+        for (int c = 0; c < 3; c++) axis[c] = next[c] / len;
+    }
+
+    // 2. 沿主轴的投影范围作为端点，向内收缩 1/16 减少量化误差
+    float minProj = 1e9f, maxProj = -1e9f;
+    for (int i = 0; i < 16; i++) {
+        float p = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] +
+                  (block[i][2] - mean[2]) * axis[2];
+        minProj = std::min(minProj, p);
+        maxProj = std::max(maxProj, p);
+    }
+    float inset = (maxProj - minProj) / 16.0f;
+    minProj += inset;
+    maxProj -= inset;
+
+    float maxColor[3], minColor[3];
+    for (int c = 0; c < 3; c++) {
+        maxColor[c] = mean[c] + axis[c] * maxProj;
+        minColor[c] = mean[c] + axis[c] * minProj;
+    }
+    uint16_t c0 = packRGB565(maxColor);
+    uint16_t c1 = packRGB565(minColor);
+    if (c0 < c1) std::swap(c0, c1);
+
+    // 3. 调色板 (c0 > c1 为 4 色模式；相等时全部取索引 0)
+    int palette[4][3];
+    unpackRGB565(c0, palette[0]);
+    unpackRGB565(c1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestDist = 1 << 30;
+            for (int p = 0; p < 4; p++) {
+                int dr = block[i][0] - palette[p][0];
+                int dg = block[i][1] - palette[p][1];
+                int db = block[i][2] - palette[p][2];
+                int dist = dr * dr + dg * dg + db * db;
+                if (dist < bestDist) { bestDist = dist; best = p; }
+            }
+            indices |= uint32_t(best) << (i * 2);
+        }
+    }
+
+    out[0] = uint8_t(c0 & 0xFF); out[1] = uint8_t(c0 >> 8);
+    out[2] = uint8_t(c1 & 0xFF); out[3] = uint8_t(c1 >> 8);
+    for (int i = 0; i < 4; i++) out[4 + i] = uint8_t(indices >> (i * 8));
+}
+
+// BC4 / BC3 alpha 块：8 值插值模式 (a0 > a1)
+void encodeScalarBlock(const uint8_t block[16][4], int channel, uint8_t *out)
+{
+    int minValue = 255, maxValue = 0;
+    for (int i = 0; i < 16; i++) {
+        minValue = std::min(minValue, int(block[i][channel]));
+        maxValue = std::max(maxValue, int(block[i][channel]));
+    }
+
+    out[0] = uint8_t(maxValue);
+    out[1] = uint8_t(minValue);
+
+    uint64_t indices = 0;
+    if (maxValue != minValue) {
+        int palette[8];
+        palette[0] = maxValue;
+        palette[1] = minValue;
+        for (int p = 1; p < 7; p++) palette[p + 1] = ((7 - p) * maxValue + p * minValue) / 7;
+
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestDist = 1 << 30;
+            for (int p = 0; p < 8; p++) {
+                int dist = std::abs(int(block[i][channel]) - palette[p]);
+                if (dist < bestDist) { bestDist = dist; best = p; }
+            }
+            indices |= uint64_t(best) << (i * 3);
+        }
+    }
+    for (int i = 0; i < 6; i++) out[2 + i] = uint8_t(indices >> (i * 8));
+}
+
+template <typename EncodeBlock>
+std::vector<uint8_t> compressImage(const Image &image, int bytesPerBlock, EncodeBlock encode)
+{
+    const int blocksX = (image.width + 3) / 4;
+    const int blocksY = (image.height + 3) / 4;
+    std::vector<uint8_t> result(size_t(blocksX) * blocksY * bytesPerBlock);
+
+    uint8_t block[16][4];
+    for (int by = 0; by < blocksY; by++) {
+        for (int bx = 0; bx < blocksX; bx++) {
+            fetchBlock(image, bx, by, block);
+            encode(block, &result[(size_t(by) * blocksX + bx) * bytesPerBlock]);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+std::vector<Image> buildMipChain(const Image &base)
+{
+    std::vector<Image> chain;
+    chain.push_back(base);
+
+    while (chain.back().width > 1 || chain.back().height > 1) {
+        const Image &src = chain.back();
+        Image dst;
+        dst.width = std::max(src.width / 2, 1);
+        dst.height = std::max(src.height / 2, 1);
+        dst.rgba.resize(size_t(dst.width) * dst.height * 4);
+
+        for (int y = 0; y < dst.height; y++) {
+            int y0 = std::min(y * 2, src.height - 1), y1 = std::min(y * 2 + 1, src.height - 1);
+            for (int x = 0; x < dst.width; x++) {
+                int x0 = std::min(x * 2, src.width - 1), x1 = std::min(x * 2 + 1, src.width - 1);
+                const uint8_t *p[4] = {
+                    &src.rgba[(size_t(y0) * src.width + x0) * 4], &src.rgba[(size_t(y0) * src.width + x1) * 4],
+                    &src.rgba[(size_t(y1) * src.width + x0) * 4], &src.rgba[(size_t(y1) * src.width + x1) * 4],
+                };
+                uint8_t *out = &dst.rgba[(size_t(y) * dst.width + x) * 4];
+                for (int c = 0; c < 4; c++) out[c] = uint8_t((p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2) / 4);
+            }
+        }
+        chain.push_back(std::move(dst));
+    }
+    return chain;
+}
+
+std::vector<uint8_t> compressBC1(const Image &image)
+{
+    return compressImage(image, 8, [](const uint8_t block[16][4], uint8_t *out) {
+        encodeColorBlock(block, out);
+    });
+}
+
+std::vector<uint8_t> compressBC3(const Image &image)
+{
+    // 前 8 字节 alpha 块，后 8 字节颜色块
+    return compressImage(image, 16, [](const uint8_t block[16][4], uint8_t *out) {
+        encodeScalarBlock(block, 3, out);
+        encodeColorBlock(block, out + 8);
+    });
+}
+
+std::vector<uint8_t> compressBC4(const Image &image)
+{
+    return compressImage(image, 8, [](const uint8_t block[16][4], uint8_t *out) {
+        encodeScalarBlock(block, 0, out);
+    });
+}
+
+} // namespace TextureCompressor
@@ -0,0 +1,285 @@
+#include "Core/TextureLoader.h"
+#include "Core/GLExtensions.h"
+#include "Core/MappedFile.h"
+#include "Core/TextureCompressor.h"
+#include "Core/ThreadPool.h"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <vector>
+#ifndef STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#endif
+
+namespace TextureLoader {
+
+// 短边小于该值的图片不做块压缩：多半是像素风皮肤，4x4 块压缩的色块很明显，省下的显存也很少
+static const int MIN_COMPRESSED_SIZE = 128;
+
+namespace {
+
+bool isFormatSupported(TextureFile::Format format, const Options &options)
+{
+    switch (format) {
+    case TextureFile::Format::RGBA8:
+    case TextureFile::Format::BC4:
+        return true;
+    case TextureFile::Format::BC1:
+    case TextureFile::Format::BC3:
+        return options.s3tcSupported;
+    }
+    return false;
+}
+
+GLenum getInternalFormat(TextureFile::Format format)
+{
+    switch (format) {
+    case TextureFile::Format::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case TextureFile::Format::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case TextureFile::Format::BC4: return GL_COMPRESSED_RED_RGTC1;
+    default: return GL_RGBA8;
+    }
+}
+
+// 按尺寸和选项选出的压缩格式 (不看图片内容)，单通道和透明度由调用者另行处理
+TextureFile::Format colorFormatFor(int width, int height, const Options &options)
+{
+    if (options.allowCompression && options.s3tcSupported && std::min(width, height) >= MIN_COMPRESSED_SIZE)
+        return TextureFile::Format::BC1;
+    return TextureFile::Format::RGBA8;
+}
+
+// 烘焙文件：mmap 后记录每一级的位置，上传时直接从映射内存读取
+bool prepareCooked(const std::string &cookedPath, const Options &options, PreparedImage &image)
+{
+    if (!image.cookedFile.open(cookedPath)) return false;
+
+    const unsigned char *bytes = image.cookedFile.getData();
+    const size_t fileSize = image.cookedFile.getSize();
+    if (fileSize < sizeof(TextureFile::Header)) return false;
+
+    TextureFile::Header header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, TextureFile::MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != TextureFile::VERSION || header.format > uint32_t(TextureFile::Format::BC4) ||
+        header.levelCount == 0) {
+        return false;
+    }
+    const auto format = static_cast<TextureFile::Format>(header.format);
+    // 驱动不支持该压缩格式，或者烘焙时的选项与当前不同 -> 视为未命中，重新烘焙
+    if (!isFormatSupported(format, options)) return false;
+    if ((header.levelCount > 1) != options.mipmaps) return false;
+    if (format != TextureFile::Format::RGBA8 && !options.allowCompression) return false;
+    // 统一格式时必须正好是按尺寸选出的那一种，否则和其他面对不上
+    if (options.uniformFormat &&
+        format != colorFormatFor(static_cast<int>(header.width), static_cast<int>(header.height), options)) {
+        return false;
+    }
+
+    const uint64_t tableEnd = sizeof(header) + uint64_t(header.levelCount) * sizeof(TextureFile::LevelEntry);
+    if (tableEnd > fileSize) return false;
+
+    std::vector<TextureFile::LevelEntry> levels(header.levelCount);
+    std::memcpy(levels.data(), bytes + sizeof(header), levels.size() * sizeof(TextureFile::LevelEntry));
+    for (const auto &level : levels) {
+        if (level.offset + level.size > fileSize) {
+            std::cerr << "[TextureFile] Corrupted cooked texture: " << cookedPath << std::endl;
+            return false;
+        }
+    }
+
+    image.format = format;
+    image.width = static_cast<int>(header.width);
+    image.height = static_cast<int>(header.height);
+    image.hasAlpha = !options.uniformFormat && (header.flags & TextureFile::FLAG_HAS_ALPHA) != 0;
+    for (const auto &level : levels) {
+        image.levels.push_back({static_cast<int>(level.width), static_cast<int>(level.height),
+                                bytes + level.offset, static_cast<size_t>(level.size)});
+    }
+    return true;
+}
+
+bool writeCooked(const std::string &cookedPath, int channels, const PreparedImage &image)
+{
+    const auto &levels = image.levels;
+    TextureFile::Header header{};
+    std::memcpy(header.magic, TextureFile::MAGIC, sizeof(header.magic));
+    header.version = TextureFile::VERSION;
+    header.format = static_cast<uint32_t>(image.format);
+    header.width = static_cast<uint32_t>(levels[0].width);
+    header.height = static_cast<uint32_t>(levels[0].height);
+    header.levelCount = static_cast<uint32_t>(levels.size());
+    header.channels = static_cast<uint32_t>(channels);
+    header.flags = image.hasAlpha ? TextureFile::FLAG_HAS_ALPHA : 0u;
+
+    std::vector<TextureFile::LevelEntry> table(levels.size());
+    uint64_t offset = sizeof(header) + table.size() * sizeof(TextureFile::LevelEntry);
+    for (size_t i = 0; i < levels.size(); i++) {
+        offset = TextureFile::alignOffset(offset);
+        table[i] = {static_cast<uint32_t>(levels[i].width), static_cast<uint32_t>(levels[i].height),
+                    offset, levels[i].size};
+        offset += levels[i].size;
+    }
+
+    std::ofstream out(cookedPath, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(table.data()),
+              static_cast<std::streamsize>(table.size() * sizeof(TextureFile::LevelEntry)));
+    for (size_t i = 0; i < levels.size(); i++) {
+        static const char zeros[TextureFile::BLOCK_ALIGNMENT] = {};
+        uint64_t pos = static_cast<uint64_t>(out.tellp());
+        if (table[i].offset > pos) out.write(zeros, static_cast<std::streamsize>(table[i].offset - pos));
+        out.write(reinterpret_cast<const char *>(levels[i].data), static_cast<std::streamsize>(levels[i].size));
+    }
+    return static_cast<bool>(out);
+}
+
+// 源图片：解码 -> mip 链 -> 压缩，并写出烘焙文件
+bool prepareSource(const std::string &sourcePath, const std::string &cookedPath, const Options &options,
+                   PreparedImage &image)
+{
+    int width, height, channels;
+    // 统一解码为 RGBA，压缩器和回退格式都按 RGBA8 处理
+    unsigned char *data = stbi_load(sourcePath.c_str(), &width, &height, &channels, 4);
+    if (!data) return false;
+
+    TextureCompressor::Image base;
+    base.width = width;
+    base.height = height;
+    base.rgba.assign(data, data + size_t(width) * height * 4);
+    stbi_image_free(data);
+
+    std::vector<TextureCompressor::Image> chain;
+    if (options.mipmaps) {
+        chain = TextureCompressor::buildMipChain(base);
+    } else {
+        chain.push_back(std::move(base));
+    }
+
+    // 选择格式：单通道 -> BC4；有透明 -> BC3；否则 BC1；不支持或图片太小 -> RGBA8
+    bool hasAlpha = false;
+    if (!options.uniformFormat && (channels == 4 || channels == 2)) {
+        const auto &rgba = chain[0].rgba;
+        for (size_t i = 3; i < rgba.size() && !hasAlpha; i += 4) hasAlpha = rgba[i] != 255;
+    }
+
+    TextureFile::Format format = TextureFile::Format::RGBA8;
+    if (options.uniformFormat) {
+        format = colorFormatFor(width, height, options);
+    } else if (options.allowCompression && std::min(width, height) >= MIN_COMPRESSED_SIZE) {
+        if (channels == 1)
+            format = TextureFile::Format::BC4;
+        else if (options.s3tcSupported)
+            format = hasAlpha ? TextureFile::Format::BC3 : TextureFile::Format::BC1;
+    }
+
+    image.format = format;
+    image.width = width;
+    image.height = height;
+    image.hasAlpha = hasAlpha;
+    image.ownedData.reserve(chain.size());
+    for (auto &level : chain) {
+        switch (format) {
+        case TextureFile::Format::BC1: image.ownedData.push_back(TextureCompressor::compressBC1(level)); break;
+        case TextureFile::Format::BC3: image.ownedData.push_back(TextureCompressor::compressBC3(level)); break;
+        case TextureFile::Format::BC4: image.ownedData.push_back(TextureCompressor::compressBC4(level)); break;
+        default: image.ownedData.push_back(std::move(level.rgba)); break;
+        }
+        const auto &bytes = image.ownedData.back();
+        image.levels.push_back({level.width, level.height, bytes.data(), bytes.size()});
+    }
+
+    if (!writeCooked(cookedPath, channels, image)) {
+        std::cout << "[TextureFile] Warning: failed to write cooked texture " << cookedPath << std::endl;
+    }
+    return true;
+}
+
+// 解码线程池 (第一次使用时创建)
+ThreadPool &getDecodePool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+} // namespace
+
+void uploadLevel(GLenum target, int level, TextureFile::Format format, int width, int height,
+                 const void *data, size_t size)
+{
+    if (format == TextureFile::Format::RGBA8) {
+        glTexImage2D(target, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    } else {
+        glCompressedTexImage2D(target, level, getInternalFormat(format), width, height, 0,
+                               static_cast<GLsizei>(size), data);
+    }
+
+    // BC4 只有 R 通道，把它复制到 G/B，采样结果与未压缩的灰度图一致
+    if (format == TextureFile::Format::BC4 && level == 0) {
+        GLenum bindTarget = target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP;
+        glTexParameteri(bindTarget, GL_TEXTURE_SWIZZLE_G, GL_RED);
+        glTexParameteri(bindTarget, GL_TEXTURE_SWIZZLE_B, GL_RED);
+    }
+}
+
+Options getDefaultOptions()
+{
+    Options options;
+    options.s3tcSupported = GLExtensions::hasS3TC();
+    return options;
+}
+
+PreparedImage prepare(const std::string &sourcePath, const Options &options)
+{
+    PreparedImage image;
+    image.sourcePath = sourcePath;
+
+    std::string cookedPath = TextureFile::getCookedPath(sourcePath);
+    if (isCookedFresh(cookedPath, sourcePath) && prepareCooked(cookedPath, options, image)) {
+#ifndef NDEBUG
+        std::cout << "[Texture] Loading Cooked Texture: " << cookedPath << std::endl;
+#endif
+        image.valid = true;
+        return image;
+    }
+
+    // 烘焙文件不可用，清掉可能读了一半的状态
+    image = PreparedImage();
+    image.sourcePath = sourcePath;
+#ifndef NDEBUG
+    std::cout << "[Texture] Cooking: " << sourcePath << std::endl;
+#endif
+    image.valid = prepareSource(sourcePath, cookedPath, options, image);
+    return image;
+}
+
+std::future<PreparedImage> prepareAsync(const std::string &sourcePath, const Options &options)
+{
+    return getDecodePool().submit([sourcePath, options]() { return prepare(sourcePath, options); });
+}
+
+bool uploadPrepared(const PreparedImage &image, GLenum target, Info &info)
+{
+    if (!image.valid || image.levels.empty()) return false;
+
+    info.width = image.width;
+    info.height = image.height;
+    info.levelCount = static_cast<int>(image.levels.size());
+    info.byteSize = 0;
+    for (size_t i = 0; i < image.levels.size(); i++) {
+        const auto &level = image.levels[i];
+        uploadLevel(target, static_cast<int>(i), image.format, level.width, level.height, level.data, level.size);
+        info.byteSize += level.size;
+    }
+    return true;
+}
+
+bool upload(const std::string &sourcePath, GLenum target, const Options &options, Info &info)
+{
+    return uploadPrepared(prepare(sourcePath, options), target, info);
+}
+
+} // namespace TextureLoader
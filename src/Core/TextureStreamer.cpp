@@ -0,0 +1,173 @@
+#include "Core/TextureStreamer.h"
+#include "Core/GLState.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+TextureStreamer::~TextureStreamer()
+{
+    for (auto &slot : slots) {
+        if (slot.fence) glDeleteSync(slot.fence);
+        if (slot.pbo) glDeleteBuffers(1, &slot.pbo);
+    }
+    for (auto &job : jobs) {
+        if (job.fence) glDeleteSync(job.fence);
+    }
+}
+
+void TextureStreamer::enqueue(std::shared_ptr<Texture2D> texture, std::future<TextureLoader::PreparedImage> image)
+{
+    Job job;
+    job.texture = std::move(texture);
+    job.future = std::move(image);
+    jobs.push_back(std::move(job));
+}
+
+TextureStreamer::Slot *TextureStreamer::acquireSlot(size_t size)
+{
+    Slot &slot = slots[nextSlot];
+    if (slot.fence) {
+        // 超时为 0：只查询，不等待
+        GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (status == GL_TIMEOUT_EXPIRED) return nullptr;
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+
+    if (!slot.pbo) glGenBuffers(1, &slot.pbo);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+    if (slot.capacity < size) {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+        slot.capacity = size;
+    }
+
+    nextSlot = (nextSlot + 1) % SLOT_COUNT;
+    return &slot;
+}
+
+bool TextureStreamer::uploadLevel(Job &job)
+{
+    const auto &level = job.image.levels[job.nextLevel];
+    Slot *slot = acquireSlot(level.size);
+    if (!slot) return false; // 环形缓冲满了，下一帧再试
+
+    // 写入 PBO：INVALIDATE 告诉驱动不需要保留旧内容，fence 已经保证 GPU 不再读取
+    void *dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(level.size),
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!dst) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+    std::memcpy(dst, level.data, level.size);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    // 绑定 PIXEL_UNPACK_BUFFER 时 data 参数是缓冲区内的偏移，拷贝由驱动异步完成
+    GLState::bindTexture(GL_TEXTURE_2D, job.texture->getNativeID());
+    TextureLoader::uploadLevel(GL_TEXTURE_2D, static_cast<int>(job.nextLevel), job.image.format,
+                               level.width, level.height, nullptr, level.size);
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // 解绑，避免之后的普通 glTexImage2D 把内存指针当成偏移
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    job.uploadedBytes += level.size;
+    job.nextLevel++;
+    if (job.nextLevel == job.image.levels.size()) {
+        job.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    return true;
+}
+
+void TextureStreamer::retireFinished()
+{
+    for (auto it = jobs.begin(); it != jobs.end();) {
+        if (!it->fence) {
+            ++it;
+            continue;
+        }
+        GLenum status = glClientWaitSync(it->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            ++it;
+            continue;
+        }
+        glDeleteSync(it->fence);
+        it->texture->setResident(it->image.width, it->image.height, it->uploadedBytes);
+        it = jobs.erase(it);
+    }
+}
+
+void TextureStreamer::update()
+{
+    if (jobs.empty()) return;
+
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    size_t bytesThisFrame = 0;
+    auto overBudget = [&]() {
+        double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        return bytesThisFrame >= budget.maxBytes || elapsed >= budget.maxMilliseconds;
+    };
+
+    for (auto it = jobs.begin(); it != jobs.end() && !overBudget();) {
+        Job &job = *it;
+
+        // 1. 解码还没完成的跳过，不阻塞 GL 线程
+        if (!job.prepared) {
+            if (job.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                ++it;
+                continue;
+            }
+            job.image = job.future.get();
+            job.prepared = true;
+            if (!job.image.valid || job.image.levels.empty()) {
+                // 失败的纹理一直保留占位白图
+                std::cerr << "Texture failed to load at path: " << job.image.sourcePath << std::endl;
+                it = jobs.erase(it);
+                continue;
+            }
+            // 透明度在解码后就已知：马上标记，材质在上传完成之前就能选到 alpha test 变体
+            job.texture->setHasAlpha(job.image.hasAlpha);
+            GLState::bindTexture(GL_TEXTURE_2D, job.texture->getNativeID());
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(job.image.levels.size()) - 1);
+        }
+
+        // 2. 逐级上传，直到用完预算或者 PBO 环形缓冲用尽
+        bool stalled = false;
+        while (job.nextLevel < job.image.levels.size() && !overBudget()) {
+            size_t size = job.image.levels[job.nextLevel].size;
+            if (!uploadLevel(job)) {
+                stalled = true;
+                break;
+            }
+            bytesThisFrame += size;
+        }
+        if (stalled) break;
+        ++it;
+    }
+
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
+    retireFinished();
+}
+
+void TextureStreamer::flush()
+{
+    Budget saved = budget;
+    budget.maxBytes = static_cast<size_t>(-1);
+    budget.maxMilliseconds = 1e9;
+
+    while (!jobs.empty()) {
+        for (auto &job : jobs) {
+            if (!job.prepared) job.future.wait();
+        }
+        update();
+        // 等待 GPU 消耗完 PBO，否则 update 会因为环形缓冲满而原地打转
+        for (auto &slot : slots) {
+            if (slot.fence) glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        }
+        for (auto &job : jobs) {
+            if (job.fence) glClientWaitSync(job.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        }
+    }
+    budget = saved;
+}
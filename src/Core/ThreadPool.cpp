@@ -0,0 +1,46 @@
+#include "Core/ThreadPool.h"
+#include <algorithm>
+
+// workerLoop 里置位，其他线程 (包括主线程) 一直为 false
+static thread_local bool insideWorker = false;
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    // 已经入队的任务会执行完再退出
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto &worker : workers) worker.join();
+}
+
+bool ThreadPool::isWorkerThread()
+{
+    return insideWorker;
+}
+
+void ThreadPool::workerLoop()
+{
+    insideWorker = true;
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return; // stopping 且队列已空
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
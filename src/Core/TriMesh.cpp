@@ -1,156 +1,191 @@
 ﻿#include "Core/TriMesh.h"
+#include "Core/GLState.h"
+#include "Core/MappedFile.h"
+#include "Core/MeshFile.h"
+#include "Core/MeshOptimizer.h"
+#include "Core/MeshSimplifier.h"
+#include "Core/ObjParser.h"
+#include "Core/QuadMerger.h"
+#include "Core/ResourceManager.h"
 #include <iostream>
-#ifndef STB_IMAGE_IMPLEMENTATION
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
-#endif
+#include <sstream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+
+namespace {
+// 顶点焊接用的键：位置 + 法线 + UV + 颜色完全相同 (逐位比较) 才算同一个顶点
+struct VertexKey {
+    float data[11];
 
-#include <tiny_obj_loader.h>
-#define TINYOBJLOADER_IMPLEMENTATION
+    VertexKey(const glm::vec3 &p, const glm::vec3 &n, const glm::vec2 &uv, const glm::vec3 &c)
+        : data{p.x, p.y, p.z, n.x, n.y, n.z, uv.x, uv.y, c.x, c.y, c.z} {}
+
+    bool operator==(const VertexKey &other) const {
+        return std::memcmp(data, other.data, sizeof(data)) == 0;
+    }
+};
+
+struct VertexKeyHash {
+    size_t operator()(const VertexKey &key) const {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(key.data);
+        for (size_t i = 0; i < sizeof(key.data); i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+} // namespace
 
-TriMesh::TriMesh() : vao(0), vbo(0), shininess(32.0f) {}
+TriMesh::TriMesh()
+    : vao(0), vbo(0), ebo(0), vertexCount(0), indexCount(0), indexType(GL_UNSIGNED_INT),
+      vertexFormat(VertexFormat::Compact), mergeCoplanar(false), retention(MeshRetention::None),
+      shininess(32.0f) {}
 
 TriMesh::~TriMesh() {
-    if (vao) glDeleteVertexArrays(1, &vao);
+    if (vao) GLState::deleteVertexArrays(1, &vao);
     if (vbo) glDeleteBuffers(1, &vbo);
+    if (ebo) glDeleteBuffers(1, &ebo);
 }
 
 // 核心函数：自适应读取 (融合贴图模型与纯色模型)
 void TriMesh::readObjTiny(const std::string &filename)
+{
+    if (parseObj(filename)) uploadToGpu();
+}
+
+// 只做 CPU 端的工作 (解析/焊接/优化/LOD)，不调用任何 GL 函数，可以在工作线程执行
+bool TriMesh::parseObj(const std::string &filename)
 {
 #ifndef NDEBUG
-    std::cout << "[TinyObj] Loading: " << filename << std::endl;
+    std::cout << "[ObjParser] Loading: " << filename << std::endl;
 #endif
 
     cleanData();
     std::string directory = filename.substr(0, filename.find_last_of('/'));
-
-    // 1. 初始化 Loader
-    tinyobj::ObjReaderConfig reader_config;
-    reader_config.mtl_search_path = directory;
-
-    tinyobj::ObjReader reader;
-    if (!reader.ParseFromFile(filename, reader_config)) {
-        if (!reader.Error().empty()) {
-            std::cerr << "TinyObj Reader Error: " << reader.Error() << std::endl;
+    sourceDirectory = directory;
+
+    // 1. 解析 OBJ (多线程分块，多边形已三角化)
+    ObjParser::Mesh obj;
+    std::string error, warning;
+    if (!ObjParser::parseFile(filename, directory, obj, error, warning)) {
+        if (!error.empty()) {
+            std::cerr << "ObjParser Error: " << error << std::endl;
         }
-        return;
+        return false;
     }
 
-    if (!reader.Warning().empty()) {
-        std::cout << "TinyObj Reader Warning: " << reader.Warning() << std::endl;
+    if (!warning.empty()) {
+        std::cout << "ObjParser Warning: " << warning << std::endl;
     }
 
-    auto& attrib = reader.GetAttrib();
-    auto& shapes = reader.GetShapes();
-    auto& materials = reader.GetMaterials();
+    const auto& materials = obj.materials;
 
     // 初始化边界
     minBound = glm::vec3(1e9f);
     maxBound = glm::vec3(-1e9f);
 
-    // 2. 预加载所有材质贴图 (模仿 Assimp 逻辑)
-    // TinyObj 的材质列表是全局的，先遍历一遍加载贴图
+    // 2. 收集所有材质贴图 (模仿 Assimp 逻辑)
+    // 材质列表是全局的，先遍历一遍记下贴图，真正的加载在 uploadToGpu 里完成
     for (const auto& mat : materials) {
-        // 辅助 lambda: 加载并去重
+        // 辅助 lambda: 记录并去重
         auto loadMap = [&](std::string texPath, std::string typeName) {
             if (texPath.empty()) return;
 
             // 检查去重
             for(const auto& t : textures) if(t.path == texPath) return;
 
-            Texture tex;
-            tex.id = loadTexture(texPath, directory); // 复用 loadTexture
-            tex.type = typeName;
-            tex.path = texPath;
-            textures.push_back(tex);
+            textures.push_back(Texture{0, typeName, texPath, nullptr});
         };
 
-        loadMap(mat.diffuse_texname, "texture_diffuse");
-        loadMap(mat.specular_texname, "texture_specular");
+        loadMap(mat.diffuseTexname, "texture_diffuse");
+        loadMap(mat.specularTexname, "texture_specular");
         // 如果 .mtl 里有 bump 贴图需要加载（我放弃了）
         // loadMap(mat.bump_texname, "texture_normal");
     }
 
-    // 3. 遍历几何体
-    // TinyObj 的数据是展平的数组，通过 index 访问
-    unsigned int baseIndex = 0; // 用于 faces 的索引偏移
-
-    for (const auto& shape : shapes) {
-        // 遍历所有面
-        size_t index_offset = 0;
-        for (size_t f = 0; f < shape.mesh.num_face_vertices.size(); f++) {
-            // 获取当前面的顶点数 (通常是 3，因为 tinyobj 默认 triangulate)
-            int fv = shape.mesh.num_face_vertices[f];
-
-            // 获取材质 ID
-            int matId = shape.mesh.material_ids[f];
-            glm::vec3 diffuseColor(1.0f);
-            if (matId >= 0 && matId < materials.size()) {
-                diffuseColor = glm::vec3(
-                    materials[matId].diffuse[0],
-                    materials[matId].diffuse[1],
-                    materials[matId].diffuse[2]
-                );
-            }
+    // 3. 遍历三角形
+    // 数据是展平的数组，通过 index 访问
+    // 完全相同的 (位置, 法线, UV, 颜色) 只保留一份，faces 存的是焊接后的索引
+    std::unordered_map<VertexKey, unsigned int, VertexKeyHash> uniqueVertices;
+    size_t rawVertexCount = 0;
+    const size_t triangleCount = obj.materialIds.size();
+
+    for (size_t f = 0; f < triangleCount; f++) {
+        // 获取材质 ID
+        int matId = obj.materialIds[f];
+        glm::vec3 diffuseColor(1.0f);
+        if (matId >= 0 && matId < static_cast<int>(materials.size())) {
+            diffuseColor = glm::vec3(
+                materials[matId].diffuse[0],
+                materials[matId].diffuse[1],
+                materials[matId].diffuse[2]
+            );
+        }
 
-            // 遍历面的每个顶点
-            for (size_t v = 0; v < fv; v++) {
-                // 获取索引
-                tinyobj::index_t idx = shape.mesh.indices[index_offset + v];
+        // 遍历面的每个顶点
+        unsigned int faceIndices[3] = {0, 0, 0};
+        for (size_t v = 0; v < 3; v++) {
+            // 获取索引
+            const ObjParser::Index& idx = obj.indices[3 * f + v];
+
+            // --- 位置 (Position) ---
+            glm::vec3 pos(
+                obj.positions[3 * idx.vertex + 0],
+                obj.positions[3 * idx.vertex + 1],
+                obj.positions[3 * idx.vertex + 2]
+            );
 
-                // --- 位置 (Position) ---
-                glm::vec3 pos(
-                    attrib.vertices[3 * idx.vertex_index + 0],
-                    attrib.vertices[3 * idx.vertex_index + 1],
-                    attrib.vertices[3 * idx.vertex_index + 2]
+            // 更新 AABB
+            minBound = glm::min(minBound, pos);
+            maxBound = glm::max(maxBound, pos);
+
+            // --- 法线 (Normal) ---
+            glm::vec3 normal(0.0f, 1.0f, 0.0f);
+            if (idx.normal >= 0) {
+                normal = glm::vec3(
+                    obj.normals[3 * idx.normal + 0],
+                    obj.normals[3 * idx.normal + 1],
+                    obj.normals[3 * idx.normal + 2]
                 );
-                vertex_positions.push_back(pos);
-
-                // 更新 AABB
-                minBound = glm::min(minBound, pos);
-                maxBound = glm::max(maxBound, pos);
-
-                // --- 法线 (Normal) ---
-                if (idx.normal_index >= 0) {
-                    vertex_normals.emplace_back(glm::vec3(
-                        attrib.normals[3 * idx.normal_index + 0],
-                        attrib.normals[3 * idx.normal_index + 1],
-                        attrib.normals[3 * idx.normal_index + 2]
-                    ));
-                } else {
-                    vertex_normals.emplace_back(glm::vec3(0.0f, 1.0f, 0.0f));
-                }
-
-                // --- 纹理坐标 (UV) ---
-                if (idx.texcoord_index >= 0) {
-                    vertex_texcoords.emplace_back(glm::vec2(
-                        attrib.texcoords[2 * idx.texcoord_index + 0],
-                        1.0f - attrib.texcoords[2 * idx.texcoord_index + 1] // [关键] 手动 Flip Y
-                    ));
-                } else {
-                    vertex_texcoords.emplace_back(glm::vec2(0.0f, 0.0f));
-                }
-
-                // --- 颜色 (Color) ---
-                vertex_colors.push_back(diffuseColor);
+            }
 
-                // --- 切线 (Tangent) ---
-                // TinyObj 不会自动计算切线。
-                // 我放弃了 Normal Map，这里只给个默认值...
+            // --- 纹理坐标 (UV) ---
+            glm::vec2 uv(0.0f, 0.0f);
+            if (idx.texcoord >= 0) {
+                uv = glm::vec2(
+                    obj.texcoords[2 * idx.texcoord + 0],
+                    1.0f - obj.texcoords[2 * idx.texcoord + 1] // [关键] 手动 Flip Y
+                );
             }
 
-            // --- 构建面索引 (Faces) ---
-            // 因为是把所有顶点按顺序 push 进去的，所以索引是线性的
-            faces.emplace_back(
-                baseIndex + 0,
-                baseIndex + 1,
-                baseIndex + 2
-            );
+            // --- 切线 (Tangent) ---
+            // 解析器不会计算切线。
+            // 我放弃了 Normal Map，这里只给个默认值...
 
-            baseIndex += 3;
-            index_offset += fv;
+            // --- 顶点焊接 ---
+            // 颜色 (Color) 来自材质，同样参与比较
+            VertexKey key(pos, normal, uv, diffuseColor);
+            auto found = uniqueVertices.find(key);
+            if (found == uniqueVertices.end()) {
+                unsigned int newIndex = static_cast<unsigned int>(vertex_positions.size());
+                vertex_positions.push_back(pos);
+                vertex_normals.push_back(normal);
+                vertex_texcoords.push_back(uv);
+                vertex_colors.push_back(diffuseColor);
+                found = uniqueVertices.emplace(key, newIndex).first;
+            }
+            faceIndices[v] = found->second;
+            rawVertexCount++;
         }
+
+        // --- 构建面索引 (Faces) ---
+        faces.emplace_back(faceIndices[0], faceIndices[1], faceIndices[2]);
     }
 
     // 4. 兜底策略：白图
@@ -160,190 +195,705 @@ void TriMesh::readObjTiny(const std::string &filename)
     }
 
     if (!hasDiffuse) {
-        Texture whiteTex;
-        whiteTex.id = loadTexture("internal_white", "");
-        whiteTex.type = "texture_diffuse";
-        whiteTex.path = "internal_white";
-        textures.push_back(whiteTex);
+        textures.push_back(Texture{0, "texture_diffuse", "internal_white", nullptr});
     }
 #ifndef NDEBUG
-    std::cout << "Loaded Model: " << filename << " | Shapes: " << shapes.size()
+    std::cout << "Loaded Model: " << filename << " | Triangles: " << triangleCount
+              << " | Vertices: " << vertex_positions.size() << " (welded from " << rawVertexCount << ")"
               << " | Textures: " << textures.size() << std::endl;
 #endif
-    // 提交 GPU
-    storeFacesPoints();
+    // 体素模型的共面合并：只对纯色 (没有真实漫反射贴图) 的模型生效，否则会破坏 UV
+    if (mergeCoplanar) {
+        if (hasDiffuse) {
+#ifndef NDEBUG
+            std::cout << "[QuadMerger] " << filename << " has textures, skipped" << std::endl;
+#endif
+        } else {
+            mergeCoplanarFaces(filename);
+        }
+    }
+
+    // 三角形/顶点重排 (结果会随烘焙文件保存，之后的启动不再重复计算)
+    optimizeMesh(filename);
+    generateLods(filename);
+
+    // 顶点数不超过 65535 时使用 16 位索引，索引缓冲减半 (烘焙文件也按这个类型写)
+    indexType = vertex_positions.size() <= 0xFFFF ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    return !faces.empty();
 }
 
-// 展平数据传给 GPU (适配 Layout 0,1,2,3)
-void TriMesh::storeFacesPoints()
+// 加载阶段的网格优化：顶点缓存 -> 过度绘制 -> 顶点读取顺序
+// 主 Pass 和阴影 Pass 都会画同一份索引，所以收益是双份的
+void TriMesh::optimizeMesh(const std::string &name)
 {
-    // 将索引数据展平
-    for (auto & face : faces)
-    {
-        // P0, P1, P2
-        points.push_back(vertex_positions[face.x]);
-        points.push_back(vertex_positions[face.y]);
-        points.push_back(vertex_positions[face.z]);
+    if (faces.empty()) return;
+
+    std::vector<unsigned int> indices;
+    indices.reserve(faces.size() * 3);
+    for (const auto &face : faces) {
+        indices.push_back(face.x);
+        indices.push_back(face.y);
+        indices.push_back(face.z);
+    }
+
+    const size_t count = vertex_positions.size();
+    float acmrBefore = MeshOptimizer::computeACMR(indices, count);
+
+    MeshOptimizer::optimizeVertexCache(indices, count);
+    MeshOptimizer::optimizeOverdraw(indices, vertex_positions);
+    std::vector<unsigned int> remap = MeshOptimizer::optimizeVertexFetch(indices, count);
+
+    float acmrAfter = MeshOptimizer::computeACMR(indices, count);
+
+    // 按新顺序重排顶点属性 (未被引用的顶点被丢弃)
+    size_t used = 0;
+    for (unsigned int r : remap) if (r != ~0u) used++;
+
+    std::vector<glm::vec3> positions(used), normals(used), colors(used);
+    std::vector<glm::vec2> uvs(used);
+    for (size_t i = 0; i < count; i++) {
+        if (remap[i] == ~0u) continue;
+        positions[remap[i]] = vertex_positions[i];
+        normals[remap[i]] = vertex_normals[i];
+        uvs[remap[i]] = vertex_texcoords[i];
+        colors[remap[i]] = vertex_colors[i];
+    }
+    vertex_positions.swap(positions);
+    vertex_normals.swap(normals);
+    vertex_texcoords.swap(uvs);
+    vertex_colors.swap(colors);
+
+    for (size_t t = 0; t < faces.size(); t++) {
+        faces[t] = vec3i(indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2]);
+    }
+
+    // 解析在工作线程上进行：先拼好整行再一次写出，避免和其他模型的输出交错
+    std::ostringstream report;
+    report << "[MeshOptimizer] " << name << " | Triangles: " << faces.size()
+           << " | ACMR: " << acmrBefore << " -> " << acmrAfter << '\n';
+    std::cout << report.str() << std::flush;
+}
+
+// 共面合并：faces 展开成索引交给 QuadMerger，新顶点追加在 vertex_* 末尾
+// 不再被引用的旧顶点会在随后的 optimizeMesh 中丢弃
+void TriMesh::mergeCoplanarFaces(const std::string &name)
+{
+    std::vector<unsigned int> indices;
+    indices.reserve(faces.size() * 3);
+    for (const auto &face : faces) {
+        indices.push_back(face.x);
+        indices.push_back(face.y);
+        indices.push_back(face.z);
+    }
+
+    const size_t before = faces.size();
+    if (!QuadMerger::mergeCoplanarQuads(vertex_positions, vertex_normals, vertex_texcoords, vertex_colors, indices)) {
+#ifndef NDEBUG
+        std::cout << "[QuadMerger] " << name << " | nothing to merge" << std::endl;
+#endif
+        return;
+    }
+
+    faces.clear();
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        faces.emplace_back(indices[t], indices[t + 1], indices[t + 2]);
+    }
+
+    // 合并改变了几何，重新计算包围盒 (去掉的只是内部面，一般不会变)
+    minBound = glm::vec3(1e9f);
+    maxBound = glm::vec3(-1e9f);
+    for (const auto &face : faces) {
+        for (unsigned int v : {face.x, face.y, face.z}) {
+            minBound = glm::min(minBound, vertex_positions[v]);
+            maxBound = glm::max(maxBound, vertex_positions[v]);
+        }
+    }
+
+#ifndef NDEBUG
+    std::cout << "[QuadMerger] " << name << " | Triangles: " << before << " -> " << faces.size() << std::endl;
+#else
+    (void)before;
+#endif
+}
 
-        normals.push_back(vertex_normals[face.x]);
-        normals.push_back(vertex_normals[face.y]);
-        normals.push_back(vertex_normals[face.z]);
+// LOD 生成：每一级在上一级的基础上减半，误差超过上限或者减不动时停止
+// 各级只是同一个 VBO 上的另一段索引，不增加顶点数据
+namespace {
+const int MAX_LOD_LEVELS = 4;                              // 含 LOD 0
+const float LOD_TARGET_ERRORS[] = {0.01f, 0.03f, 0.08f};   // LOD 1~3 允许的相对误差
+const float LOD_MIN_REDUCTION = 0.85f;                     // 三角形数至少减少 15% 才值得多一级
+const size_t LOD_MIN_TRIANGLES = 64;                       // 太简单的模型不生成 LOD
+}
 
-        texcoords.push_back(vertex_texcoords[face.x]);
-        texcoords.push_back(vertex_texcoords[face.y]);
-        texcoords.push_back(vertex_texcoords[face.z]);
+void TriMesh::generateLods(const std::string &name)
+{
+    lodIndices.clear();
+    lods.clear();
+    const GLsizei baseCount = static_cast<GLsizei>(faces.size() * 3);
+    lods.push_back({0, baseCount, 0.0f});
+    if (faces.size() < LOD_MIN_TRIANGLES) return;
+
+    std::vector<unsigned int> previous;
+    previous.reserve(faces.size() * 3);
+    for (const auto &face : faces) {
+        previous.push_back(face.x);
+        previous.push_back(face.y);
+        previous.push_back(face.z);
+    }
 
-        colors.push_back(vertex_colors[face.x]);
-        colors.push_back(vertex_colors[face.y]);
-        colors.push_back(vertex_colors[face.z]);
+    float accumulatedError = 0.0f;
+    for (int level = 1; level < MAX_LOD_LEVELS; level++) {
+        float error = 0.0f;
+        size_t target = previous.size() / 6 * 3;
+        std::vector<unsigned int> simplified = MeshSimplifier::simplify(
+            previous, vertex_positions, vertex_normals, vertex_texcoords, vertex_colors,
+            target, LOD_TARGET_ERRORS[level - 1], &error);
+        if (simplified.empty() || simplified.size() > previous.size() * LOD_MIN_REDUCTION) break;
+
+        // 每一级各自做顶点缓存优化 (顶点顺序已由 LOD 0 决定，这里只重排三角形)
+        MeshOptimizer::optimizeVertexCache(simplified, vertex_positions.size());
+
+        accumulatedError += error;
+        GLsizei offset = baseCount + static_cast<GLsizei>(lodIndices.size());
+        lods.push_back({offset, static_cast<GLsizei>(simplified.size()), accumulatedError});
+        lodIndices.insert(lodIndices.end(), simplified.begin(), simplified.end());
+        previous.swap(simplified);
     }
 
+#ifndef NDEBUG
+    std::ostringstream report;
+    report << "[LOD] " << name << " | Triangles:";
+    for (const auto &lod : lods) report << " " << lod.indexCount / 3;
+    report << '\n';
+    std::cout << report.str() << std::flush;
+#endif
+}
+
+int TriMesh::clampLod(int lod) const
+{
+    if (lod <= 0 || lods.empty()) return 0;
+    return std::min(lod, static_cast<int>(lods.size()) - 1);
+}
+
+// 上传焊接后的顶点 (适配 Layout 0,1,2,3) 与索引缓冲
+void TriMesh::storeFacesPoints()
+{
+    vertexCount = static_cast<GLsizei>(vertex_positions.size());
+    indexCount = static_cast<GLsizei>(faces.size() * 3 + lodIndices.size());
+    if (vertexCount == 0 || indexCount == 0) return;
+    if (lods.empty()) lods.push_back({0, static_cast<GLsizei>(faces.size() * 3), 0.0f});
+
     if (!vao) glGenVertexArrays(1, &vao);
     if (!vbo) glGenBuffers(1, &vbo);
+    if (!ebo) glGenBuffers(1, &ebo);
 
-    glBindVertexArray(vao);
+    GLState::bindVertexArray(vao);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
 
-    size_t size_p = points.size() * sizeof(glm::vec3);
-    size_t size_n = normals.size() * sizeof(glm::vec3);
-    size_t size_t1 = texcoords.size() * sizeof(glm::vec2);
-    size_t size_c = colors.size() * sizeof(glm::vec3);
-
-    // 分配总内存
-    glBufferData(GL_ARRAY_BUFFER, size_p + size_n + size_t1 + size_c, nullptr, GL_STATIC_DRAW);
-
-    // 填充子数据
-    glBufferSubData(GL_ARRAY_BUFFER, 0, size_p, &points[0]);
-    glBufferSubData(GL_ARRAY_BUFFER, size_p, size_n, &normals[0]);
-    glBufferSubData(GL_ARRAY_BUFFER, size_p + size_n, size_t1, &texcoords[0]);
-    glBufferSubData(GL_ARRAY_BUFFER, size_p + size_n + size_t1, size_c, &colors[0]);
+    // 按当前格式打包成交错顶点，一次上传
+    std::vector<unsigned char> vertexData = VertexLayout::pack(
+        vertexFormat, vertex_positions, vertex_normals, vertex_texcoords, vertex_colors);
+    glBufferData(GL_ARRAY_BUFFER, vertexData.size(), vertexData.data(), GL_STATIC_DRAW);
 
-    // Layout 0: Position
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void *)0);
-    glEnableVertexAttribArray(0);
+    // 索引缓冲 (EBO 绑定记录在 VAO 里)
+    // 顶点数不超过 65535 时使用 16 位索引，索引缓冲减半
+    indexType = vertex_positions.size() <= 0xFFFF ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    std::vector<unsigned char> indexData = buildIndexData(indexType);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexData.size(), indexData.data(), GL_STATIC_DRAW);
 
-    // Layout 1: Normal
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (void *)size_p);
-    glEnableVertexAttribArray(1);
+    VertexLayout::setupAttributes(vertexFormat);
+    GLState::bindVertexArray(0);
+}
 
-    // Layout 2: TexCoord
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, (void *)(size_p + size_n));
-    glEnableVertexAttribArray(2);
+// 按指定的索引类型把 faces (LOD 0) 和 lodIndices 打包成 EBO 字节
+std::vector<unsigned char> TriMesh::buildIndexData(GLenum type) const
+{
+    std::vector<unsigned char> data;
+    const size_t total = faces.size() * 3 + lodIndices.size();
+    if (type == GL_UNSIGNED_SHORT) {
+        std::vector<unsigned short> shorts;
+        shorts.reserve(total);
+        for (const auto &face : faces) {
+            shorts.push_back(static_cast<unsigned short>(face.x));
+            shorts.push_back(static_cast<unsigned short>(face.y));
+            shorts.push_back(static_cast<unsigned short>(face.z));
+        }
+        for (unsigned int index : lodIndices) shorts.push_back(static_cast<unsigned short>(index));
+        data.resize(shorts.size() * sizeof(unsigned short));
+        std::memcpy(data.data(), shorts.data(), data.size());
+    } else {
+        data.resize(total * sizeof(unsigned int));
+        unsigned int *dst = reinterpret_cast<unsigned int *>(data.data());
+        for (const auto &face : faces) {
+            *dst++ = face.x;
+            *dst++ = face.y;
+            *dst++ = face.z;
+        }
+        if (!lodIndices.empty()) std::memcpy(dst, lodIndices.data(), lodIndices.size() * sizeof(unsigned int));
+    }
+    return data;
+}
 
-    // Layout 3: Color (新增)
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 0, (void *)(size_p + size_n + size_t1));
-    glEnableVertexAttribArray(3);
+// 烘焙格式加载：整个文件 mmap 进来，顶点块直接作为 glBufferData 的数据源
+bool TriMesh::loadCooked(const std::string &filename)
+{
+    if (!mapCooked(filename)) return false;
+    uploadToGpu();
+    return true;
 }
 
-// 纹理加载 (含默认白图生成)
-unsigned int TriMesh::loadTexture(const std::string &path, const std::string &directory)
+// 映射并校验烘焙文件 (不调用 GL，可以在工作线程执行)，映射保留到 uploadToGpu 上传完为止
+bool TriMesh::mapCooked(const std::string &filename)
 {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-
-    // 特殊标记：生成 1x1 白色纹理
-    // 用于给没有贴图的模型（如钻石剑）提供默认颜色乘数
-    if (path == "internal_white") {
-        unsigned char white[] = {255, 255, 255, 255}; // RGBA
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
-
-        // 设置过滤参数，否则纹理可能无法采样
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        return textureID;
-    }
-
-    // 标准文件加载逻辑
-    std::string filename = directory + '/' + path;
+    MappedFile file;
+    if (!file.open(filename)) return false;
+
+    const unsigned char *bytes = file.getData();
+    const size_t fileSize = file.getSize();
+    if (fileSize < sizeof(MeshFile::Header)) return false;
+
+    MeshFile::Header header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, MeshFile::MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != MeshFile::VERSION ||
+        (header.vertexFormat != uint32_t(VertexFormat::Float) &&
+         header.vertexFormat != uint32_t(VertexFormat::Compact))) {
+        return false;
+    }
+    // 烘焙时的格式/处理选项与当前要求的不同 -> 视为未命中，重新解析并覆盖烘焙文件
+    if (static_cast<VertexFormat>(header.vertexFormat) != vertexFormat) return false;
+    if (((header.flags & MeshFile::FLAG_MERGED_COPLANAR) != 0) != mergeCoplanar) return false;
+
+    // 校验各数据块没有越界 (防止截断的文件)
+    const uint64_t materialBytes = uint64_t(header.materialCount) * sizeof(MeshFile::MaterialEntry);
+    const uint64_t lodBytes = uint64_t(header.lodCount) * sizeof(MeshFile::LodEntry);
+    const uint64_t expectedVertexBytes = uint64_t(header.vertexCount) * VertexLayout::getStride(vertexFormat);
+    const bool validIndexSize = header.indexSize == sizeof(unsigned short) ||
+                                header.indexSize == sizeof(unsigned int);
+    if (header.materialOffset + materialBytes > fileSize ||
+        header.lodOffset + lodBytes > fileSize || header.lodCount == 0 ||
+        header.vertexOffset + header.vertexBytes > fileSize ||
+        header.indexOffset + header.indexBytes > fileSize ||
+        header.vertexBytes != expectedVertexBytes || !validIndexSize ||
+        header.indexBytes != uint64_t(header.indexCount) * header.indexSize) {
+        std::cerr << "[MeshFile] Corrupted cooked mesh: " << filename << std::endl;
+        return false;
+    }
+
+    cleanData();
+    sourceDirectory = filename.substr(0, filename.find_last_of('/'));
+
+    minBound = glm::vec3(header.minBound[0], header.minBound[1], header.minBound[2]);
+    maxBound = glm::vec3(header.maxBound[0], header.maxBound[1], header.maxBound[2]);
+
+    // LOD 表
+    for (uint32_t i = 0; i < header.lodCount; i++) {
+        MeshFile::LodEntry entry;
+        std::memcpy(&entry, bytes + header.lodOffset + i * sizeof(entry), sizeof(entry));
+        if (uint64_t(entry.indexOffset) + entry.indexCount > header.indexCount) {
+            std::cerr << "[MeshFile] Corrupted LOD table: " << filename << std::endl;
+            lods.clear();
+            return false;
+        }
+        lods.push_back({static_cast<GLsizei>(entry.indexOffset), static_cast<GLsizei>(entry.indexCount), entry.error});
+    }
+
+    // 材质表 (贴图在 uploadToGpu 里加载)
+    for (uint32_t i = 0; i < header.materialCount; i++) {
+        MeshFile::MaterialEntry entry;
+        std::memcpy(&entry, bytes + header.materialOffset + i * sizeof(entry), sizeof(entry));
+        entry.type[sizeof(entry.type) - 1] = '\0';
+        entry.path[sizeof(entry.path) - 1] = '\0';
+        textures.push_back(Texture{0, entry.type, entry.path, nullptr});
+    }
+
+    vertexCount = static_cast<GLsizei>(header.vertexCount);
+    indexCount = static_cast<GLsizei>(header.indexCount);
+    indexType = header.indexSize == sizeof(unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    // 烘焙加载本来就不经过 vertex_* 数组，只在需要时从映射的文件里取一份位置副本
+    if (retention == MeshRetention::Positions)
+        retainFromCooked(bytes + header.vertexOffset, bytes + header.indexOffset, header.indexSize);
+
+    cookedVertexData = bytes + header.vertexOffset;
+    cookedVertexBytes = header.vertexBytes;
+    cookedIndexData = bytes + header.indexOffset;
+    cookedIndexBytes = header.indexBytes;
+    cookedFile = std::move(file);
+
 #ifndef NDEBUG
-    std::cout << "[Texture Debug] Trying to load: " << filename << std::endl;
+    std::cout << "Loaded Cooked Model: " << filename << " | Vertices: " << vertexCount
+              << " | Triangles: " << lods[0].indexCount / 3 << " | LODs: " << lods.size()
+              << " | Textures: " << textures.size() << std::endl;
 #endif
-    int width, height, nrComponents;
-    // stbi_set_flip_vertically_on_load(true);
+    return true;
+}
 
-    unsigned char *data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        GLenum format;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA; // [关键] Minecraft 皮肤必须支持 RGBA 透明通道
+// 写出烘焙格式：与 storeFacesPoints 上传到 VBO/EBO 的字节布局完全一致
+bool TriMesh::saveCooked(const std::string &filename) const
+{
+    if (vertex_positions.empty() || faces.empty()) return false;
+    for (const auto &tex : textures) {
+        if (tex.type.size() >= sizeof(MeshFile::MaterialEntry::type) ||
+            tex.path.size() >= sizeof(MeshFile::MaterialEntry::path)) {
+            return false; // 路径过长，放弃烘焙 (下次仍然走 OBJ)
+        }
+    }
+
+    MeshFile::Header header{};
+    std::memcpy(header.magic, MeshFile::MAGIC, sizeof(header.magic));
+    header.version = MeshFile::VERSION;
+    header.vertexCount = static_cast<uint32_t>(vertex_positions.size());
+    header.indexCount = static_cast<uint32_t>(faces.size() * 3 + lodIndices.size());
+    header.indexSize = indexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int);
+    header.materialCount = static_cast<uint32_t>(textures.size());
+    for (int i = 0; i < 3; i++) {
+        header.minBound[i] = minBound[i];
+        header.maxBound[i] = maxBound[i];
+    }
 
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
+    header.materialOffset = MeshFile::alignOffset(sizeof(MeshFile::Header));
+    header.lodOffset = MeshFile::alignOffset(
+        header.materialOffset + uint64_t(header.materialCount) * sizeof(MeshFile::MaterialEntry));
+
+    // 没有生成过 LOD 时只写 LOD 0
+    std::vector<MeshLod> lodTable = lods;
+    if (lodTable.empty()) lodTable.push_back({0, static_cast<GLsizei>(faces.size() * 3), 0.0f});
+    header.lodCount = static_cast<uint32_t>(lodTable.size());
+    header.vertexOffset = MeshFile::alignOffset(
+        header.lodOffset + uint64_t(header.lodCount) * sizeof(MeshFile::LodEntry));
+    header.vertexFormat = static_cast<uint32_t>(vertexFormat);
+    header.flags = mergeCoplanar ? MeshFile::FLAG_MERGED_COPLANAR : 0u;
+
+    std::vector<unsigned char> vertexData = VertexLayout::pack(
+        vertexFormat, vertex_positions, vertex_normals, vertex_texcoords, vertex_colors);
+    header.vertexBytes = vertexData.size();
+    header.indexOffset = MeshFile::alignOffset(header.vertexOffset + header.vertexBytes);
+
+    std::vector<unsigned char> indexData = buildIndexData(indexType);
+    header.indexBytes = indexData.size();
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    auto pad = [&out](uint64_t offset) {
+        static const char zeros[MeshFile::BLOCK_ALIGNMENT] = {};
+        uint64_t pos = static_cast<uint64_t>(out.tellp());
+        if (offset > pos) out.write(zeros, static_cast<std::streamsize>(offset - pos));
+    };
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    pad(header.materialOffset);
+    for (const auto &tex : textures) {
+        MeshFile::MaterialEntry entry{};
+        std::strncpy(entry.type, tex.type.c_str(), sizeof(entry.type) - 1);
+        std::strncpy(entry.path, tex.path.c_str(), sizeof(entry.path) - 1);
+        out.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+    }
+
+    pad(header.lodOffset);
+    for (const auto &lod : lodTable) {
+        MeshFile::LodEntry entry{};
+        entry.indexOffset = static_cast<uint32_t>(lod.indexOffset);
+        entry.indexCount = static_cast<uint32_t>(lod.indexCount);
+        entry.error = lod.error;
+        out.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+    }
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    pad(header.vertexOffset);
+    out.write(reinterpret_cast<const char *>(vertexData.data()), static_cast<std::streamsize>(vertexData.size()));
+
+    pad(header.indexOffset);
+    out.write(reinterpret_cast<const char *>(indexData.data()), static_cast<std::streamsize>(indexData.size()));
+
+    return static_cast<bool>(out);
+}
 
-        // Minecraft 风格使用 GL_NEAREST (邻近采样) 保持像素颗粒感
-        // 如果要平滑效果则使用 GL_LINEAR_MIPMAP_LINEAR
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+std::vector<std::string> TriMesh::getTexturePaths() const
+{
+    std::vector<std::string> paths;
+    for (const auto &tex : textures) {
+        if (tex.path != "internal_white") paths.push_back(sourceDirectory + '/' + tex.path);
+    }
+    return paths;
+}
 
-        stbi_image_free(data);
+// GL 线程：加载贴图并上传顶点/索引 (来自 parseObj 的数组或 mapCooked 的映射)
+void TriMesh::uploadToGpu()
+{
+    // 贴图先全部交给解码线程池，再按顺序取回
+    ResourceManager::getInstance().prefetchTextures(getTexturePaths());
+    for (auto &tex : textures) {
+        if (!tex.resource) tex = acquireTexture(tex.path, sourceDirectory, tex.type);
     }
-    else
-    {
-        std::cerr << "Texture failed to load at path: " << filename << std::endl;
-        stbi_image_free(data);
+
+    if (!cookedFile.isOpen()) {
+        storeFacesPoints();
+        return;
     }
 
-    return textureID;
+    if (!vao) glGenVertexArrays(1, &vao);
+    if (!vbo) glGenBuffers(1, &vbo);
+    if (!ebo) glGenBuffers(1, &ebo);
+
+    GLState::bindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(cookedVertexBytes), cookedVertexData, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(cookedIndexBytes), cookedIndexData, GL_STATIC_DRAW);
+
+    VertexLayout::setupAttributes(vertexFormat);
+    GLState::bindVertexArray(0);
+
+    // 数据已经交给驱动，解除映射
+    cookedFile.close();
+    cookedVertexData = cookedIndexData = nullptr;
+    cookedVertexBytes = cookedIndexBytes = 0;
+}
+
+// 纹理加载：实际的解码和 GL 对象都在 ResourceManager 里，同一路径只加载一次
+Texture TriMesh::acquireTexture(const std::string &path, const std::string &directory, const std::string &type)
+{
+    Texture tex;
+    tex.type = type;
+    tex.path = path;
+    if (path == "internal_white")
+        tex.resource = ResourceManager::getInstance().getWhiteTexture();
+    else
+        tex.resource = ResourceManager::getInstance().getTexture(directory + '/' + path);
+    tex.id = tex.resource ? tex.resource->getID() : 0;
+    return tex;
+}
+
+bool TriMesh::hasAlphaTexture() const
+{
+    for (const auto &tex : textures)
+        if (tex.type == "texture_diffuse" && tex.resource && tex.resource->hasAlpha()) return true;
+    return false;
+}
+
+bool TriMesh::hasPendingTextures() const
+{
+    for (const auto &tex : textures)
+        if (tex.resource && !tex.resource->isResident()) return true;
+    return false;
+}
+
+bool TriMesh::hasSpecularMap() const
+{
+    for (const auto &tex : textures)
+        if (tex.type == "texture_specular") return true;
+    return false;
 }
 
+// 每次绘制都要设置的 uniform (哈希在编译期算好)
+static constexpr Uniform<glm::mat4> U_MODEL("model");
+static constexpr Uniform<float> U_SHININESS("material.shininess");
+
 // 纯几何绘制：适用于阴影生成阶段 (Shadow Pass)
 // 不需要传 View/Proj，也不需要绑定纹理，只需要 Model 矩阵
-void TriMesh::drawGeometry(GLuint program, const glm::mat4 &model) {
-    glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &model[0][0]);
+void TriMesh::drawGeometry(const Shader &shader, const glm::mat4 &model, int lod) {
+    shader.set(U_MODEL, model);
 
-    glBindVertexArray(vao);
-    glDrawArrays(GL_TRIANGLES, 0, points.size());
-    glBindVertexArray(0);
+    GLState::bindVertexArray(vao);
+    drawLod(lod);
 }
 
-// 标准绘制：适用于主渲染阶段 (已解耦 View/Proj)
-void TriMesh::draw(GLuint program, const glm::mat4 &model)
+void TriMesh::drawGeometryInstanced(GLuint instanceBuffer, GLsizei firstInstance, GLsizei count, int lod) {
+    if (count <= 0) return;
+    GLState::bindVertexArray(vao);
+    bindInstanceAttributes(instanceBuffer, firstInstance);
+    drawLod(lod, count);
+}
+
+// 画指定 LOD 对应的那一段索引 (调用前需绑定 VAO)
+// instanceCount > 0 时为实例化绘制
+void TriMesh::drawLod(int lod, GLsizei instanceCount) const
+{
+    if (lods.empty()) return;
+    const MeshLod &range = lods[clampLod(lod)];
+    const size_t indexSize = indexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int);
+    const void *offset = reinterpret_cast<const void *>(static_cast<size_t>(range.indexOffset) * indexSize);
+    if (instanceCount > 0)
+        glDrawElementsInstanced(GL_TRIANGLES, range.indexCount, indexType, offset, instanceCount);
+    else
+        glDrawElements(GL_TRIANGLES, range.indexCount, indexType, offset);
+}
+
+void TriMesh::bindInstanceAttributes(GLuint instanceBuffer, GLsizei firstInstance) const
+{
+    // mat4 占 4 个属性槽，每个槽一列，每个实例前进一次
+    const size_t base = static_cast<size_t>(firstInstance) * sizeof(glm::mat4);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    for (GLuint column = 0; column < 4; column++)
+    {
+        GLuint location = 4 + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                              reinterpret_cast<const void *>(base + column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(location, 1);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void TriMesh::bindMaterial(const Shader &shader) const
 {
     unsigned int diffuseNr = 1;
     unsigned int specularNr = 1;
 
     for (unsigned int i = 0; i < textures.size(); i++)
     {
-        glActiveTexture(GL_TEXTURE0 + i);
-        std::string name = textures[i].type;
-        std::string number;
+        const std::string &name = textures[i].type;
+
+        // texture_diffuse1 / texture_specular1 ...：按编号接着类型名哈希，不拼字符串
+        UniformId sampler = name;
+        if (name == "texture_diffuse") sampler = UniformId::element("texture_diffuse", diffuseNr++, "");
+        else if (name == "texture_specular") sampler = UniformId::element("texture_specular", specularNr++, "");
 
-        if (name == "texture_diffuse") number = std::to_string(diffuseNr++);
-        else if (name == "texture_specular") number = std::to_string(specularNr++);
+        shader.setInt(sampler, i);
+        // 共享纹理可能还在流式上传，此时 getID 返回占位白图
+        GLState::bindTextureUnit(i, GL_TEXTURE_2D, textures[i].resource ? textures[i].resource->getID() : textures[i].id);
+    }
+
+    // 补回材质的高光系数
+    shader.set(U_SHININESS, shininess);
+}
 
-        glUniform1i(glGetUniformLocation(program, (name + number).c_str()), i);
-        glBindTexture(GL_TEXTURE_2D, textures[i].id);
+bool TriMesh::sharesMaterial(const TriMesh &other) const
+{
+    if (this == &other) return true;
+    if (shininess != other.shininess || textures.size() != other.textures.size()) return false;
+    for (size_t i = 0; i < textures.size(); i++)
+    {
+        const Texture &a = textures[i];
+        const Texture &b = other.textures[i];
+        if (a.type != b.type) return false;
+        // 共享纹理按资源比较 (流式上传期间 ID 会变)，旧式纹理按 ID 比较
+        if (a.resource || b.resource) { if (a.resource != b.resource) return false; }
+        else if (a.id != b.id) return false;
     }
+    return true;
+}
+
+uint16_t TriMesh::getMaterialKey() const
+{
+    // FNV-1a 折叠到 16 位
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](uint64_t value) {
+        for (int i = 0; i < 8; i++)
+        {
+            hash ^= static_cast<uint8_t>(value >> (i * 8));
+            hash *= 16777619u;
+        }
+    };
+    for (const Texture &tex : textures)
+        mix(tex.resource ? reinterpret_cast<uintptr_t>(tex.resource.get()) : tex.id);
+    uint32_t shininessBits;
+    std::memcpy(&shininessBits, &shininess, sizeof(shininessBits));
+    mix(shininessBits);
+    return static_cast<uint16_t>(hash ^ (hash >> 16));
+}
+
+// 标准绘制：适用于主渲染阶段 (已解耦 View/Proj)
+void TriMesh::draw(const Shader &shader, const glm::mat4 &model, int lod)
+{
+    bindMaterial(shader);
 
     // 上传 Model 矩阵
-    glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &model[0][0]);
+    shader.set(U_MODEL, model);
 
-    // 补回材质的高光系数
-    glUniform1f(glGetUniformLocation(program, "material.shininess"), shininess);
+    GLState::bindVertexArray(vao);
+    drawLod(lod);
+}
 
-    glBindVertexArray(vao);
-    glDrawArrays(GL_TRIANGLES, 0, points.size());
+void TriMesh::drawInstanced(const Shader &shader, GLuint instanceBuffer, GLsizei firstInstance, GLsizei count, int lod)
+{
+    if (count <= 0) return;
+    bindMaterial(shader);
 
-    // 恢复默认
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(0);
+    GLState::bindVertexArray(vao);
+    bindInstanceAttributes(instanceBuffer, firstInstance);
+    drawLod(lod, count);
 }
 
 void TriMesh::cleanData()
 {
     vertex_positions.clear(); vertex_normals.clear(); vertex_texcoords.clear(); vertex_colors.clear();
-    faces.clear(); points.clear(); normals.clear(); texcoords.clear(); colors.clear();
+    faces.clear();
+    lodIndices.clear(); lods.clear();
     textures.clear();
-}
\ No newline at end of file
+    retainedPositions.clear(); retainedIndices.clear();
+}
+
+// clear() 不会归还容量，用 swap 真正释放
+template <typename T>
+static void releaseVector(std::vector<T> &v)
+{
+    std::vector<T>().swap(v);
+}
+
+void TriMesh::releaseCpuData()
+{
+    if (retention == MeshRetention::Positions && !vertex_positions.empty()) {
+        // 只保留 LOD 0 的位置和索引 (法线/UV/颜色对物理和拾取没用)
+        retainedPositions.assign(vertex_positions.begin(), vertex_positions.end());
+        retainedIndices.clear();
+        retainedIndices.reserve(faces.size() * 3);
+        for (const auto &face : faces) {
+            retainedIndices.push_back(face.x);
+            retainedIndices.push_back(face.y);
+            retainedIndices.push_back(face.z);
+        }
+    }
+
+    releaseVector(vertex_positions);
+    releaseVector(vertex_normals);
+    releaseVector(vertex_texcoords);
+    releaseVector(vertex_colors);
+    releaseVector(faces);
+    releaseVector(lodIndices);
+}
+
+void TriMesh::retainFromCooked(const unsigned char *vertexBytes, const unsigned char *indexBytes, size_t indexSize)
+{
+    // 两种顶点格式的前 12 个字节都是 float 位置
+    const GLsizei stride = VertexLayout::getStride(vertexFormat);
+    retainedPositions.resize(vertexCount);
+    for (GLsizei i = 0; i < vertexCount; i++)
+        std::memcpy(&retainedPositions[i], vertexBytes + size_t(i) * stride, sizeof(glm::vec3));
+
+    const MeshLod &base = lods[0];
+    retainedIndices.resize(base.indexCount);
+    const unsigned char *src = indexBytes + size_t(base.indexOffset) * indexSize;
+    for (GLsizei i = 0; i < base.indexCount; i++) {
+        if (indexSize == sizeof(unsigned short)) {
+            unsigned short index;
+            std::memcpy(&index, src + size_t(i) * indexSize, sizeof(index));
+            retainedIndices[i] = index;
+        } else {
+            std::memcpy(&retainedIndices[i], src + size_t(i) * indexSize, sizeof(unsigned int));
+        }
+    }
+}
+
+MeshMemoryStats TriMesh::getMemoryStats() const
+{
+    MeshMemoryStats stats{};
+    stats.cpuBytes = vertex_positions.capacity() * sizeof(glm::vec3) +
+                     vertex_normals.capacity() * sizeof(glm::vec3) +
+                     vertex_texcoords.capacity() * sizeof(glm::vec2) +
+                     vertex_colors.capacity() * sizeof(glm::vec3) +
+                     faces.capacity() * sizeof(vec3i) +
+                     lodIndices.capacity() * sizeof(unsigned int) +
+                     lods.capacity() * sizeof(MeshLod) +
+                     textures.capacity() * sizeof(Texture) +
+                     retainedPositions.capacity() * sizeof(glm::vec3) +
+                     retainedIndices.capacity() * sizeof(unsigned int);
+
+    const size_t indexSize = indexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int);
+    stats.gpuBytes = size_t(vertexCount) * VertexLayout::getStride(vertexFormat) + size_t(indexCount) * indexSize;
+    return stats;
+}
@@ -0,0 +1,114 @@
+#include "Core/VertexFormat.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace VertexLayout {
+
+GLsizei getStride(VertexFormat format) {
+    return format == VertexFormat::Compact ? sizeof(CompactVertex) : sizeof(FloatVertex);
+}
+
+// float32 -> float16 (就近舍入，溢出截断为 Inf，非规格化数直接冲刷为 0)
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+    uint32_t mantissa = bits & 0x007FFFFFu;
+
+    if (((bits >> 23) & 0xFFu) == 0xFFu) {
+        // NaN / Inf
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+    }
+    if (exponent <= 0) {
+        return static_cast<uint16_t>(sign);
+    }
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    // 就近舍入 (进位可能顺延到指数位，结果依然正确)
+    if (mantissa & 0x1000u) half++;
+    return static_cast<uint16_t>(half);
+}
+
+// 法线 -> GL_INT_2_10_10_10_REV (x 在低位，w 固定为 0)
+uint32_t packNormal(const glm::vec3& normal) {
+    auto packComponent = [](float v) -> uint32_t {
+        v = std::max(-1.0f, std::min(1.0f, v));
+        int32_t q = static_cast<int32_t>(std::lround(v * 511.0f));
+        return static_cast<uint32_t>(q) & 0x3FFu;
+    };
+    return packComponent(normal.x) | (packComponent(normal.y) << 10) | (packComponent(normal.z) << 20);
+}
+
+static uint8_t packUnorm8(float v) {
+    v = std::max(0.0f, std::min(1.0f, v));
+    return static_cast<uint8_t>(std::lround(v * 255.0f));
+}
+
+std::vector<unsigned char> pack(VertexFormat format,
+                                const std::vector<glm::vec3>& positions,
+                                const std::vector<glm::vec3>& normals,
+                                const std::vector<glm::vec2>& texcoords,
+                                const std::vector<glm::vec3>& colors) {
+    const size_t count = positions.size();
+    std::vector<unsigned char> data(count * getStride(format));
+
+    if (format == VertexFormat::Compact) {
+        CompactVertex* dst = reinterpret_cast<CompactVertex*>(data.data());
+        for (size_t i = 0; i < count; i++) {
+            CompactVertex& v = dst[i];
+            v.position[0] = positions[i].x;
+            v.position[1] = positions[i].y;
+            v.position[2] = positions[i].z;
+            v.normal = packNormal(normals[i]);
+            v.texcoord[0] = floatToHalf(texcoords[i].x);
+            v.texcoord[1] = floatToHalf(texcoords[i].y);
+            v.color[0] = packUnorm8(colors[i].r);
+            v.color[1] = packUnorm8(colors[i].g);
+            v.color[2] = packUnorm8(colors[i].b);
+            v.color[3] = 255;
+        }
+    } else {
+        FloatVertex* dst = reinterpret_cast<FloatVertex*>(data.data());
+        for (size_t i = 0; i < count; i++) {
+            FloatVertex& v = dst[i];
+            std::memcpy(v.position, &positions[i].x, sizeof(v.position));
+            std::memcpy(v.normal, &normals[i].x, sizeof(v.normal));
+            std::memcpy(v.texcoord, &texcoords[i].x, sizeof(v.texcoord));
+            std::memcpy(v.color, &colors[i].x, sizeof(v.color));
+        }
+    }
+    return data;
+}
+
+void setupAttributes(VertexFormat format) {
+    const GLsizei stride = getStride(format);
+
+    if (format == VertexFormat::Compact) {
+        // Layout 0: Position
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(CompactVertex, position));
+        // Layout 1: Normal (硬件解包为 [-1, 1])
+        glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(CompactVertex, normal));
+        // Layout 2: TexCoord
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(CompactVertex, texcoord));
+        // Layout 3: Color (硬件解包为 [0, 1])
+        glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(CompactVertex, color));
+    } else {
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(FloatVertex, position));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(FloatVertex, normal));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(FloatVertex, texcoord));
+        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(FloatVertex, color));
+    }
+
+    for (GLuint i = 0; i < 4; i++) {
+        glEnableVertexAttribArray(i);
+    }
+}
+
+} // namespace VertexLayout
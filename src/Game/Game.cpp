@@ -1,8 +1,17 @@
 #include "Game/Game.h"
 #include "Game/UIManager.h"
 #include "Core/ResourceManager.h"
+#include "Core/ShaderLibrary.h"
+#include "Core/GLState.h"
 #include <iostream>
 
+static const char* LIGHTING_VS = "assets/shaders/lighting_vs.glsl";
+static const char* LIGHTING_FS = "assets/shaders/lighting_fs.glsl";
+static const char* DEPTH_VS = "assets/shaders/shadow_depth_vs.glsl";
+static const char* DEPTH_FS = "assets/shaders/shadow_depth_fs.glsl";
+// 阴影贴图固定绑定的纹理单元 (避开模型贴图用的低编号单元)
+static const int SHADOW_MAP_UNIT = 10;
+
 Game::Game(unsigned int width, unsigned int height)
     : State(GAME_MENU), Width(width), Height(height), pressB(false), pressT(false), window(nullptr)
 {
@@ -13,16 +22,37 @@ Game::~Game() {
 }
 
 void Game::Init() {
-    // 1. Shader
-    lightingShader = std::make_shared<Shader>("assets/shaders/lighting_vs.glsl", "assets/shaders/lighting_fs.glsl");
-
-    depthShader = std::make_shared<Shader>("assets/shaders/shadow_depth_vs.glsl", "assets/shaders/shadow_depth_fs.glsl");
+    // 1. Shader (主光照着色器依赖地图里的点光源个数，放好点光源后再提交)
+    // 这里只提交编译，和后面的模型加载重叠，第一帧之前统一 finishAll
+    ShaderLibrary& shaders = ShaderLibrary::getInstance();
+    depthShader = shaders.request(DEPTH_VS, DEPTH_FS);
+    instancedDepthShader = shaders.request(DEPTH_VS, DEPTH_FS, {"INSTANCED"});
 
     // 2. LightManager
     lightManager = std::make_shared<LightManager>();
     lightManager->init();
     lightManager->initShadows();
 
+    // 地图的点光源只是一张表，先放好，主光照着色器才能在加载模型之前提交编译
+    scene = std::make_shared<Scene>();
+    scene->loadLights(lightManager);
+
+    // 主光照着色器的变体：阴影 + 固定个数的点光源 (聚光灯关闭，没有高光贴图)
+    // 不透明物体不做 alpha test，保留提前深度测试；角色皮肤的透明层需要 alpha test
+    // 地图里的静态物体按网格实例化绘制，另有一组 INSTANCED 变体
+    ShaderDefines lightingDefines = {"HAS_SHADOWS",
+                                     "NUM_POINT_LIGHTS=" + std::to_string(lightManager->getStreetLamps().size())};
+    ShaderDefines alphaTestDefines = lightingDefines;
+    alphaTestDefines.push_back("ALPHA_TEST");
+    ShaderDefines instancedDefines = lightingDefines;
+    instancedDefines.push_back("INSTANCED");
+    ShaderDefines instancedAlphaTestDefines = alphaTestDefines;
+    instancedAlphaTestDefines.push_back("INSTANCED");
+    lightingShaders.opaque = shaders.request(LIGHTING_VS, LIGHTING_FS, lightingDefines);
+    lightingShaders.alphaTest = shaders.request(LIGHTING_VS, LIGHTING_FS, alphaTestDefines);
+    lightingShaders.instanced = shaders.request(LIGHTING_VS, LIGHTING_FS, instancedDefines);
+    lightingShaders.instancedAlphaTest = shaders.request(LIGHTING_VS, LIGHTING_FS, instancedAlphaTestDefines);
+
     // 3. Camera
     camera = std::make_shared<Camera>(glm::vec3(0.0f, 3.0f, 18.0f));
     camera->MovementSpeed = 7.0f;
@@ -39,12 +69,11 @@ void Game::Init() {
     currentCharacter = steve;
 
     // 5. Scene (初始化资源)
-    scene = std::make_shared<Scene>();
     scene->init();
 
     // 6. 加载地图 (生成物体和碰撞盒)
     // 以后可以改成 scene->loadMap("level1.txt");
-    scene->loadMap(lightManager);
+    scene->loadMap();
 
     // 7. Controller
     camController = std::make_shared<CameraController>(camera, currentCharacter);
@@ -56,6 +85,23 @@ void Game::Init() {
     // 9. 获取碰撞数据。Game 不再自己算碰撞盒，问 Scene 要
     staticObstacles = scene->getObstacles();
 
+    // 10. 等待还在编译的着色器 (UI 初始化期间驱动已经在编译)
+    shaders.finishAll();
+
+    // 采样器编号是程序自己的状态，各变体设置一次即可
+    for (Shader* variant : {lightingShaders.opaque.get(), lightingShaders.alphaTest.get(),
+                            lightingShaders.instanced.get(), lightingShaders.instancedAlphaTest.get()}) {
+        variant->use();
+        variant->setInt("shadowMap", SHADOW_MAP_UNIT);
+    }
+
+#ifndef NDEBUG
+    ResourceManager::getInstance().printMemoryReport();
+#endif
+
+    // 启动资源已经同步加载完毕，之后 (换地图/新角色) 的贴图走流式上传，避免卡帧
+    ResourceManager::getInstance().setTextureStreaming(true);
+
     std::cout << "Game Init Complete." << std::endl;
 }
 
@@ -183,6 +229,12 @@ void Game::Update(float dt) {
 }
 
 void Game::Render() {
+    // 结算上一帧的 GL 调用计数 (HUD 显示)
+    GLState::beginFrame();
+
+    // 完成后台模型的 GL 上传，并推进流式纹理上传 (每帧有预算上限)
+    ResourceManager::getInstance().update();
+
     // Pass 1: Shadow Map Generation (阴影生成阶段)
     // 获取 Steve 的位置作为阴影中心
     glm::vec3 centerPos = currentCharacter->getPosition();
@@ -190,24 +242,39 @@ void Game::Render() {
     // 计算跟随玩家的光照矩阵
     glm::mat4 lightProjectionView = lightManager->getLightSpaceMatrix(centerPos);
 
+    glm::mat4 view = camera->GetViewMatrix();
+    const float farPlane = 100.0f;
+    glm::mat4 projection = glm::perspective(glm::radians(camera->Zoom), (float)Width / (float)Height, 0.1f, farPlane);
+
+    // 1. 每帧数据和光照一次性写进 UBO，之后所有着色器 (阴影/主光照/替身/天空盒) 直接读取
+    FrameData frame;
+    frame.view = view;
+    frame.projection = projection;
+    frame.lightSpaceMatrix = lightProjectionView;
+    frame.viewPos = glm::vec4(camera->Position, 1.0f);
+    frameBuffer.update(&frame);
+    // 光照只在变化时上传
+    lightManager->upload();
 
     // 2. 配置管线
     depthShader->use();
-    depthShader->setMat4("lightSpaceMatrix", lightProjectionView);
 
     glViewport(0, 0, lightManager->getShadowWidth(), lightManager->getShadowHeight());
-    glBindFramebuffer(GL_FRAMEBUFFER, lightManager->getShadowFBO());
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, lightManager->getShadowFBO());
     glClear(GL_DEPTH_BUFFER_BIT);
 
     // 3. 绘制场景几何体 (注意：需要修改 Steve 和 Scene 增加 drawShadow 接口)
     // 这里的 cull face 设置是为了防止彼得潘悬浮(Peter Panning)现象，可选
+    // 深度钳制：位于光源近平面之前的投射者不会被裁掉，而是压到最近的深度 (见 Scene::drawShadow)
     glCullFace(GL_FRONT);
+    glEnable(GL_DEPTH_CLAMP);
     steve->drawShadow(*depthShader);
     alex->drawShadow(*depthShader);
-    scene->drawShadow(*depthShader);
+    scene->drawShadow(*depthShader, *instancedDepthShader, lightProjectionView);
+    glDisable(GL_DEPTH_CLAMP);
     glCullFace(GL_BACK);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
     // Pass 2: Normal Rendering (正常渲染阶段)
     // 1. 重置视口和缓冲
@@ -218,32 +285,28 @@ void Game::Render() {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // 2. 配置 Lighting Shader 全局参数 (替代了 TriMesh 里的逻辑)
-    lightingShader->use();
-
-    glm::mat4 view = camera->GetViewMatrix();
-    glm::mat4 projection = glm::perspective(glm::radians(camera->Zoom), (float)Width / (float)Height, 0.1f, 100.0f);
-
-    lightingShader->setMat4("view", view);
-    lightingShader->setMat4("projection", projection);
-    lightingShader->setVec3("viewPos", camera->Position);
-
-    // 传入阴影相关参数
-    lightingShader->setMat4("lightSpaceMatrix", lightProjectionView);
-
-    // 绑定阴影贴图 (例如绑定到纹理单元 10，避免和模型纹理冲突)
-    glActiveTexture(GL_TEXTURE10);
-    glBindTexture(GL_TEXTURE_2D, lightManager->getShadowMap());
-    lightingShader->setInt("shadowMap", 10);
-
-    // 应用光照参数
-    lightManager->apply(*lightingShader);
-
-    // 3. 绘制物体 (使用修改后的 draw 接口，不再传 view/proj)
-    steve->draw(*lightingShader);
-    alex->draw(*lightingShader);
-    scene->draw(*lightingShader, view, projection, lightManager.get());
-
-    // 4. UI 绘制
+    // View/Proj/viewPos/lightSpaceMatrix 和光照参数都已经在 UBO 里
+    // 绑定阴影贴图 (采样器编号已在 Init 里设置好)
+    GLState::bindTextureUnit(SHADOW_MAP_UNIT, GL_TEXTURE_2D, lightManager->getShadowMap());
+
+    // 3. 视锥剔除 (阴影 Pass 已经画完，视野外的物体照样投影)
+    Frustum frustum = Frustum::fromMatrix(projection * view);
+    scene->cull(frustum);
+
+    // 4. 绘制物体：角色和场景先放进队列，按 (Pass, 程序, 材质, VAO, 距离) 排序后统一提交
+    // 角色皮肤有透明层的部件用 alpha test 变体，其余部件 (例如剑) 走不透明 Pass
+    renderQueue.begin(camera->Position, farPlane);
+    if (frustum.intersects(steve->getRenderBounds()))
+        steve->draw(renderQueue, *lightingShaders.opaque, *lightingShaders.alphaTest);
+    if (frustum.intersects(alex->getRenderBounds()))
+        alex->draw(renderQueue, *lightingShaders.opaque, *lightingShaders.alphaTest);
+    scene->draw(renderQueue, lightingShaders, view, projection);
+    renderQueue.submit();
+
+    // 天体、替身和天空盒在近处物体之后直接画
+    scene->drawFarField(*lightingShaders.opaque, view, lightManager.get());
+
+    // 5. UI 绘制
     uiManager->Render(*this);
 }
 
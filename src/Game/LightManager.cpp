@@ -1,5 +1,7 @@
 #include "Game/LightManager.h"
+#include "Core/GLState.h"
 #include <string>
+#include <algorithm>
 #include <glm/ext/matrix_clip_space.hpp>
 #include <glm/ext/matrix_transform.hpp>
 
@@ -48,11 +50,13 @@ int LightManager::addPointLight(glm::vec3 pos, glm::vec3 color)
     }
 
     streetLamps.push_back(lamp);
+    dirty = true;
     return streetLamps.size() - 1;
 }
 void LightManager::clearPointLights()
 {
     streetLamps.clear();
+    dirty = true;
 }
 
 // 实现接口
@@ -61,6 +65,7 @@ void LightManager::setLampPosition(int index, glm::vec3 pos)
     if (index >= 0 && index < streetLamps.size())
     {
         streetLamps[index].position = pos;
+        dirty = true;
     }
 }
 
@@ -75,6 +80,7 @@ void LightManager::toggleDayNight()
 
 void LightManager::setDay()
 {
+    dirty = true;
     // 1. 全局光照设置 (保持你之前的修改)
     currentSkyColor = glm::vec3(0.53f, 0.81f, 0.92f);
 
@@ -114,6 +120,7 @@ void LightManager::setDay()
 
 void LightManager::setNight()
 {
+    dirty = true;
     // 1. 全局光照设置
     currentSkyColor = glm::vec3(0.02f, 0.02f, 0.08f);
 
@@ -147,33 +154,35 @@ void LightManager::setNight()
     moonConfig.emissionDiffuse = glm::vec3(0.3f);
 }
 
-void LightManager::apply(Shader &shader)
+void LightManager::upload()
 {
-    // 1. 设置方向光 (Sun/moon)
-    shader.setVec3("dirLight.direction", sun.direction);
-    shader.setVec3("dirLight.ambient", sun.ambient);
-    shader.setVec3("dirLight.diffuse", sun.diffuse);
-    shader.setVec3("dirLight.specular", sun.specular);
-
-    // 动态循环，不再写死 i < 4
-    // 还要告诉 Shader 实际有多少个灯
-    shader.setInt("nr_point_lights", (int)streetLamps.size());
-
-    for (size_t i = 0; i < streetLamps.size(); i++)
+    if (!dirty)
+        return;
+
+    LightData data{};
+    // 1. 方向光 (Sun/moon)
+    data.dirLight.direction = sun.direction;
+    data.dirLight.ambient = sun.ambient;
+    data.dirLight.diffuse = sun.diffuse;
+    data.dirLight.specular = sun.specular;
+
+    // 2. 点光源：还要告诉 Shader 实际有多少个灯
+    int count = std::min((int)streetLamps.size(), MAX_UBO_POINT_LIGHTS);
+    data.nrPointLights = count;
+    for (int i = 0; i < count; i++)
     {
-        std::string base = "pointLights[" + std::to_string(i) + "]";
-        shader.setVec3(base + ".position", streetLamps[i].position);
-        shader.setVec3(base + ".ambient", streetLamps[i].ambient);
-        shader.setVec3(base + ".diffuse", streetLamps[i].diffuse);
-        shader.setVec3(base + ".specular", streetLamps[i].specular);
-        shader.setFloat(base + ".constant", streetLamps[i].constant);
-        shader.setFloat(base + ".linear", streetLamps[i].linear);
-        shader.setFloat(base + ".quadratic", streetLamps[i].quadratic);
+        PointLightStd140 &dst = data.pointLights[i];
+        dst.position = streetLamps[i].position;
+        dst.ambient = streetLamps[i].ambient;
+        dst.diffuse = streetLamps[i].diffuse;
+        dst.specular = streetLamps[i].specular;
+        dst.constant = streetLamps[i].constant;
+        dst.linear = streetLamps[i].linear;
+        dst.quadratic = streetLamps[i].quadratic;
     }
 
-    // 3. 聚光灯 (暂时关闭)
-    shader.setVec3("spotLight.diffuse", glm::vec3(0.0f));
-    shader.setFloat("spotLight.constant", 1.0f);
+    lightBuffer.update(&data);
+    dirty = false;
 }
 
 // 初始化阴影 FBO
@@ -183,7 +192,7 @@ void LightManager::initShadows()
 
     // 创建深度纹理
     glGenTextures(1, &depthMap);
-    glBindTexture(GL_TEXTURE_2D, depthMap);
+    GLState::bindTexture(GL_TEXTURE_2D, depthMap);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT,
                  SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
 
@@ -197,7 +206,7 @@ void LightManager::initShadows()
     glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
 
     // 绑定到 FBO
-    glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthMap, 0);
     // 我们不需要颜色缓冲，显式告诉 OpenGL
     glDrawBuffer(GL_NONE);
@@ -206,7 +215,7 @@ void LightManager::initShadows()
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         std::cout << "Shadow Framebuffer not complete!" << std::endl;
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 glm::mat4 LightManager::getLightSpaceMatrix(glm::vec3 centerPos) const
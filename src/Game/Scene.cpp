@@ -1,16 +1,76 @@
 #include "Game/Scene.h"
 #include <iostream>
+#include <algorithm>
+#include <limits>
 #include <glm/gtc/matrix_transform.hpp>
 #include "Core/ResourceManager.h"
 #include "Game/LightManager.h" // 需要引用完整定义以访问 getStreetLamps
 #include "Core/Skybox.h"
-
-Scene::Scene() {}
+#include "Core/ShaderLibrary.h"
+
+// LOD 切换阈值：包围球直径占屏幕高度的比例低于 LOD_SCREEN_THRESHOLDS[i] 时使用 LOD i+1
+static const float LOD_SCREEN_THRESHOLDS[] = {0.25f, 0.12f, 0.05f};
+static const int LOD_THRESHOLD_COUNT = sizeof(LOD_SCREEN_THRESHOLDS) / sizeof(LOD_SCREEN_THRESHOLDS[0]);
+// 迟滞带宽：需要越过阈值 ±15% 才真正切换
+static const float LOD_HYSTERESIS = 0.15f;
+// 替身切换的迟滞：距离需要越过阈值 ±5% 才切换
+static const float IMPOSTOR_HYSTERESIS = 0.05f;
+// 世界空间包围盒最长边小于它的物体 (脚下的碎石) 不投射阴影，影子小到几乎看不见
+static const float MIN_SHADOW_CASTER_SIZE = 1.0f;
+
+// 天体自发光 (lighting_fs / impostor_fs 共用的名字)
+static constexpr Uniform<bool> U_EMISSIVE("emissive");
+static constexpr Uniform<glm::vec3> U_EMISSION_AMBIENT("emissionAmbient");
+static constexpr Uniform<glm::vec3> U_EMISSION_DIFFUSE("emissionDiffuse");
+
+// 地图的路灯布局 (loadLights 放置点光源，loadMap 在同样的位置放灯柱)
+struct LampConfig
+{
+    glm::vec3 pos;
+    glm::vec3 color;
+};
+static const LampConfig MAP_LAMPS[] = {
+    // [灯1] 右前路引：稍微调亮一点，作为主光源
+    {glm::vec3(5.0f, 4.0f, 6.0f), glm::vec3(1.2f, 1.1f, 1.0f)},
+    // [灯2] 露营暖光
+    {glm::vec3(16.0f, 4.5f, -2.0f), glm::vec3(1.0f, 0.6f, 0.3f)},
+    // [灯3] 森林冷光
+    {glm::vec3(-12.0f, 4.0f, -6.0f), glm::vec3(0.4f, 0.6f, 1.0f)},
+    // [灯4] 远景背光
+    {glm::vec3(0.0f, 5.0f, -25.0f), glm::vec3(0.8f, 0.8f, 0.9f)}};
+
+Scene::Scene() : impostorDistance(30.0f) {}
+
+// 局部包围盒的 8 个角变换到世界空间后重新取包围盒
+static AABB transformBounds(const glm::vec3 &minB, const glm::vec3 &maxB, const glm::mat4 &model)
+{
+    AABB result;
+    result.min = glm::vec3(std::numeric_limits<float>::max());
+    result.max = glm::vec3(-std::numeric_limits<float>::max());
+    for (int corner = 0; corner < 8; corner++)
+    {
+        glm::vec3 local((corner & 1) ? maxB.x : minB.x, (corner & 2) ? maxB.y : minB.y,
+                        (corner & 4) ? maxB.z : minB.z);
+        glm::vec3 world = glm::vec3(model * glm::vec4(local, 1.0f));
+        result.min = glm::min(result.min, world);
+        result.max = glm::max(result.max, world);
+    }
+    return result;
+}
 
 void Scene::init()
 {
+    // 后台并行解析，下面的 getMesh 只需等待并上传
+    ResourceManager::getInstance().getMeshAsync("assets/models/scene/plane.obj");
+    ResourceManager::getInstance().getMeshAsync("assets/models/sun/model.obj");
+    ResourceManager::getInstance().getMeshAsync("assets/models/moon/moon.obj");
+    // 替身着色器同样先提交编译，烘焙前再等待
+    impostorBakeShader = ShaderLibrary::getInstance().request("assets/shaders/impostor_bake_vs.glsl", "assets/shaders/impostor_bake_fs.glsl");
+    impostorShader = ShaderLibrary::getInstance().request("assets/shaders/impostor_vs.glsl", "assets/shaders/impostor_fs.glsl");
+
     // 1. 地面
     ground = ResourceManager::getInstance().getMesh("assets/models/scene/plane.obj");
+    groundBounds = transformBounds(ground->getMinBound(), ground->getMaxBound(), glm::scale(glm::mat4(1.0f), glm::vec3(5.0f)));
 
     // 2. 太阳 & 月亮 (动态物体单独保留)
     sunMesh = ResourceManager::getInstance().getMesh("assets/models/sun/model.obj");
@@ -20,48 +80,55 @@ void Scene::init()
     skybox = std::make_shared<Skybox>();
     skybox->init();
 
+    // 4. 替身，天体始终在远处，直接烘焙
+    impostorBakeShader->finish();
+    impostorShader->finish();
+    sunImpostor = getImpostor(sunMesh);
+    moonImpostor = getImpostor(moonMesh);
+
     std::cout << "Scene initialized." << std::endl;
 }
 
-void Scene::loadMap(const std::shared_ptr<LightManager> &lightManager)
+void Scene::loadLights(const std::shared_ptr<LightManager> &lightManager)
+{
+    lightManager->clearPointLights();
+    for (const auto &cfg : MAP_LAMPS)
+        lightManager->addPointLight(cfg.pos, cfg.color);
+
+    if (lightManager->isNightMode())
+    {
+        lightManager->setNight();
+    }
+    else
+    {
+        lightManager->setDay();
+    }
+}
+
+void Scene::loadMap()
 {
     renderQueue.clear();
+    instanceGroups.clear();
     collisionBoxes.clear();
-    lightManager->clearPointLights();
+
+    // 地图用到的模型先全部交给后台线程并行解析，addStaticObject 里的 getMesh 只需等待并上传
+    static const char* mapModels[] = {
+        "assets/models/street_lamp/model.obj", "assets/models/rock/model.obj",
+        "assets/models/bush/model.obj",        "assets/models/another_tree/model.obj",
+        "assets/models/pine_tree/model.obj",   "assets/models/park_bench/model.obj",
+        "assets/models/camp_fire/model.obj",   "assets/models/soccer_ball/model.obj"};
+    for (const char* path : mapModels) ResourceManager::getInstance().getMeshAsync(path);
 
     // ==========================================
     // 1. 灯光布局
     // ==========================================
-    struct LampConfig
+    // 灯柱 (点光源已经在 loadLights 里放好)
+    for (const auto &cfg : MAP_LAMPS)
     {
-        glm::vec3 pos;
-        glm::vec3 color;
-    };
-    std::vector<LampConfig> lamps = {
-        // [灯1] 右前路引：稍微调亮一点，作为主光源
-        {glm::vec3(5.0f, 4.0f, 6.0f), glm::vec3(1.2f, 1.1f, 1.0f)},
-        // [灯2] 露营暖光
-        {glm::vec3(16.0f, 4.5f, -2.0f), glm::vec3(1.0f, 0.6f, 0.3f)},
-        // [灯3] 森林冷光
-        {glm::vec3(-12.0f, 4.0f, -6.0f), glm::vec3(0.4f, 0.6f, 1.0f)},
-        // [灯4] 远景背光
-        {glm::vec3(0.0f, 5.0f, -25.0f), glm::vec3(0.8f, 0.8f, 0.9f)}};
-
-    for (const auto &cfg : lamps)
-    {
-        lightManager->addPointLight(cfg.pos, cfg.color);
         glm::vec3 modelPos = cfg.pos;
         modelPos.y = 0.0f;
         addStaticObject("assets/models/street_lamp/model.obj", modelPos, 2.5f, 0.5f);
     }
-    if (lightManager->isNightMode())
-    {
-        lightManager->setNight();
-    }
-    else
-    {
-        lightManager->setDay();
-    }
 
     // 2. 环境造景
 
@@ -76,7 +143,7 @@ void Scene::loadMap(const std::shared_ptr<LightManager> &lightManager)
     addStaticObject("assets/models/bush/model.obj", glm::vec3(15.0f, 0.0f, 12.0f), 12.0f, 2.0f);
 
     // 2. 左边的一棵树，增加包围感
-    addStaticObject("assets/models/another_tree/model.obj", glm::vec3(-9.0f, 0.0f, 10.0f), 4.5f, 0.6f);
+    addStaticObject("assets/models/another_tree/model.obj", glm::vec3(-9.0f, 0.0f, 10.0f), 4.5f, 0.6f, true);
     // 树下的灌木 (Scale 10.0)
     addStaticObject("assets/models/bush/model.obj", glm::vec3(-8.0f, 0.0f, 11.0f), 10.0f, 1.5f);
 
@@ -92,9 +159,10 @@ void Scene::loadMap(const std::shared_ptr<LightManager> &lightManager)
 
     // [Zone B] 右侧露营地
     // 布局维持之前的三角形结构，微调灌木大小
-    addStaticObject("assets/models/another_tree/model.obj", glm::vec3(15.0f, 0.0f, -8.0f), 5.5f, 0.8f);
+    addStaticObject("assets/models/another_tree/model.obj", glm::vec3(15.0f, 0.0f, -8.0f), 5.5f, 0.8f, true);
     addStaticObject("assets/models/park_bench/model.obj", glm::vec3(13.0f, 0.0f, -5.0f), 2.0f, 3.0f);
-    addStaticObject("assets/models/camp_fire/model.obj", glm::vec3(10.0f, 0.0f, -3.0f), 0.04f, 1.5f);
+    // 篝火自己发光，不接收阴影
+    addStaticObject("assets/models/camp_fire/model.obj", glm::vec3(10.0f, 0.0f, -3.0f), 0.04f, 1.5f, false, true, false);
 
     // 外围保护圈
     addStaticObject("assets/models/rock/model.obj", glm::vec3(16.0f, 0.0f, -4.0f), 1.2f, 0.8f);
@@ -103,9 +171,9 @@ void Scene::loadMap(const std::shared_ptr<LightManager> &lightManager)
 
     // [Zone C] 左侧野生林地
     // 树木
-    addStaticObject("assets/models/pine_tree/model.obj", glm::vec3(-12.0f, 0.0f, -6.0f), 5.5f, 1.0f);
-    addStaticObject("assets/models/pine_tree/model.obj", glm::vec3(-18.0f, 0.0f, -10.0f), 6.0f, 1.2f);
-    addStaticObject("assets/models/pine_tree/model.obj", glm::vec3(-10.0f, 0.0f, -14.0f), 4.5f, 0.8f);
+    addStaticObject("assets/models/pine_tree/model.obj", glm::vec3(-12.0f, 0.0f, -6.0f), 5.5f, 1.0f, true);
+    addStaticObject("assets/models/pine_tree/model.obj", glm::vec3(-18.0f, 0.0f, -10.0f), 6.0f, 1.2f, true);
+    addStaticObject("assets/models/pine_tree/model.obj", glm::vec3(-10.0f, 0.0f, -14.0f), 4.5f, 0.8f, true);
 
     // 填充灌木 (Scale 10.0~12.0)
     addStaticObject("assets/models/bush/model.obj", glm::vec3(-14.0f, 0.0f, -8.0f), 10.0f, 1.5f);
@@ -117,17 +185,23 @@ void Scene::loadMap(const std::shared_ptr<LightManager> &lightManager)
 
     // [Zone D] 远景球门
     addStaticObject("assets/models/rock/model.obj", glm::vec3(0.0f, 0.0f, -22.0f), 3.0f, 2.0f);
-    addStaticObject("assets/models/another_tree/model.obj", glm::vec3(7.0f, 0.0f, -23.0f), 4.0f, 0.6f);
-    addStaticObject("assets/models/pine_tree/model.obj", glm::vec3(-7.0f, 0.0f, -23.0f), 5.0f, 1.0f);
+    addStaticObject("assets/models/another_tree/model.obj", glm::vec3(7.0f, 0.0f, -23.0f), 4.0f, 0.6f, true);
+    addStaticObject("assets/models/pine_tree/model.obj", glm::vec3(-7.0f, 0.0f, -23.0f), 5.0f, 1.0f, true);
 
     // [Center] 足球
     addStaticObject("assets/models/soccer_ball/model.obj", glm::vec3(0.0f, 0.0f, 2.0f), 0.000001f, 0.5f);
 
-    std::cout << "Map Loaded: " << renderQueue.size() << " objects." << std::endl;
+    buildInstanceGroups();
+    objectBounds.clear();
+    for (const SceneObject &obj : renderQueue)
+        objectBounds.push(obj.worldBounds);
+    std::cout << "Map Loaded: " << renderQueue.size() << " objects, " << instanceGroups.size() << " meshes."
+              << std::endl;
 }
 
 // 通用物体添加函数 (自动计算贴地和碰撞)
-void Scene::addStaticObject(const std::string &path, glm::vec3 pos, float scale, float colliderWidth)
+void Scene::addStaticObject(const std::string &path, glm::vec3 pos, float scale, float colliderWidth,
+                            bool allowImpostor, bool castsShadows, bool receivesShadows)
 {
     auto mesh = ResourceManager::getInstance().getMesh(path);
 
@@ -146,8 +220,19 @@ void Scene::addStaticObject(const std::string &path, glm::vec3 pos, float scale,
     model = glm::translate(model, glm::vec3(pos.x, pos.y + yOffset, pos.z));
     model = glm::scale(model, glm::vec3(scale));
 
-    // 4. 存入渲染队列
-    renderQueue.push_back({mesh, model});
+    // 4. 存入渲染队列 (同时记录世界空间包围球，供 LOD 选择)
+    SceneObject obj;
+    obj.mesh = mesh;
+    obj.modelMatrix = model;
+    obj.worldCenter = glm::vec3(model * glm::vec4((minB + maxB) * 0.5f, 1.0f));
+    obj.boundingRadius = glm::length(maxB - minB) * 0.5f * scale;
+    obj.worldBounds = transformBounds(minB, maxB, model);
+    glm::vec3 worldSize = obj.worldBounds.max - obj.worldBounds.min;
+    obj.castsShadows = castsShadows && std::max(worldSize.x, std::max(worldSize.y, worldSize.z)) >= MIN_SHADOW_CASTER_SIZE;
+    obj.receivesShadows = receivesShadows;
+    if (allowImpostor)
+        obj.impostor = getImpostor(mesh);
+    renderQueue.push_back(obj);
 
     // 5. 生成碰撞盒 (如果需要)
     if (colliderWidth > 0.0f)
@@ -165,56 +250,217 @@ void Scene::addStaticObject(const std::string &path, glm::vec3 pos, float scale,
     }
 }
 
-void Scene::draw(Shader &shader, const glm::mat4 &view, const glm::mat4 &projection, LightManager *lights)
+void Scene::draw(RenderQueue &queue, const LightingShaders &shaders, const glm::mat4 &view,
+                 const glm::mat4 &projection)
 {
-    // 1. 绘制地面
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::scale(model, glm::vec3(5.0f));
-    // 只传 ID 和 Model，不再传 View/Proj
-    ground->draw(shader.ID, model);
+    // 相机位置从 View 矩阵反推；projection[1][1] = 1 / tan(fov / 2)
+    glm::vec3 cameraPos = glm::vec3(glm::inverse(view)[3]);
+    float projScale = projection[1][1];
+
+    // 1. 地面
+    if (groundVisible)
+        queue.draw(RenderQueue::PASS_OPAQUE, *shaders.opaque, *ground, glm::scale(glm::mat4(1.0f), glm::vec3(5.0f)));
 
-    // 2. 绘制天体 (太阳/月亮)
+    // 2. 静态物体：先逐个选 LOD / 替身，远处的树木留给 drawFarField (视锥外的直接跳过)
+    impostorObjects.clear();
+    for (auto &obj : renderQueue)
+    {
+        if (!obj.visible)
+            continue;
+        float distance = std::max(glm::length(obj.worldCenter - cameraPos), 0.001f);
+        float screenSize = obj.boundingRadius * projScale / distance;
+        obj.lod = selectLod(obj.lod, obj.mesh->getLodCount(), screenSize);
+
+        obj.usingImpostor = obj.impostor && shouldUseImpostor(obj.usingImpostor, distance);
+        if (obj.usingImpostor)
+            impostorObjects.push_back(&obj);
+    }
+
+    // 3. 其余的按 (网格, LOD) 拼成实例化批次放进队列，由队列排序后统一提交
+    prepareInstanceBatches(true, cameraPos);
+    for (const InstanceBatch &batch : instanceBatches)
+    {
+        const InstanceGroup &group = *batch.group;
+        // 每帧重新判断：流式纹理解码完成后才知道有没有透明像素
+        bool alphaTest = group.mesh->hasAlphaTexture();
+        queue.drawInstanced(alphaTest ? RenderQueue::PASS_ALPHA_TEST : RenderQueue::PASS_OPAQUE,
+                            alphaTest ? *shaders.instancedAlphaTest : *shaders.instanced, *group.mesh,
+                            instanceBuffer.getID(), batch.firstInstance, batch.count, batch.lod,
+                            batch.nearestDistance, group.receivesShadows);
+    }
+}
+
+void Scene::drawFarField(Shader &shader, const glm::mat4 &view, LightManager *lights)
+{
+    glm::vec3 cameraPos = glm::vec3(glm::inverse(view)[3]);
+    shader.use();
+
+    // 1. 绘制天体 (太阳/月亮)
     if (lights)
     {
         // 内部实现也去掉了 View/Proj 的传递
-        drawCelestialBody(sunMesh, shader, lights, true);
-        drawCelestialBody(moonMesh, shader, lights, false);
+        drawCelestialBody(sunMesh, shader, lights, true, cameraPos);
+        drawCelestialBody(moonMesh, shader, lights, false, cameraPos);
     }
 
-    // 3. 绘制所有静态物体
-    for (const auto &obj : renderQueue)
+    // 2. 远处的树木 (替身面片)
+    if (!impostorObjects.empty())
     {
-        // 只传 ID 和 Model
-        obj.mesh->draw(shader.ID, obj.modelMatrix);
+        // 矩阵和光照都在共享的 UBO 里，切换着色器后不需要重新设置
+        impostorShader->use();
+
+        for (const SceneObject *obj : impostorObjects)
+            obj->impostor->draw(*impostorShader, obj->modelMatrix, cameraPos);
+
+        // 切回主光照着色器，后续调用者仍然在用它
+        shader.use();
     }
 
-    // 4. Skybox
-    // Skybox 使用独立的 Shader，所以仍然需要手动传 View/Proj
+    // 3. Skybox
+    // Skybox 使用独立的 Shader，View/Proj 同样来自 FrameData UBO
     if (lights)
     {
-        skybox->draw(view, projection, lights->isNightMode());
+        skybox->draw(lights->isNightMode());
     }
 }
 
 // 阴影生成
-void Scene::drawShadow(Shader &shader)
+void Scene::drawShadow(Shader &shader, Shader &instancedShader, const glm::mat4 &lightSpaceMatrix)
 {
-    // 1. 地面投射阴影
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::scale(model, glm::vec3(5.0f));
-    ground->drawGeometry(shader.ID, model);
+    // 1. 地面在所有物体下面，挡不住任何东西，不画进阴影贴图
 
     // 2. 静态物体投射阴影
-    for (const auto &obj : renderQueue)
+    // 只保留光源视锥内的投射者；近平面去掉，光源和阴影体积之间的物体同样保留
+    // (阴影 Pass 打开了 GL_DEPTH_CLAMP，它们会被压到最近的深度上)
+    Frustum lightFrustum = Frustum::fromMatrix(lightSpaceMatrix);
+    lightFrustum.removeNearPlane();
+    lightFrustum.cull(objectBounds, shadowVisibility);
+
+    // 沿用主 Pass 上一帧选出的 LOD，保证阴影轮廓与屏幕上的模型一致
+    // 使用替身的远景物体仍然用几何体投射阴影 (面片会随相机转动，阴影会跟着闪)
+    prepareInstanceBatches(false);
+    if (!instanceBatches.empty())
     {
-        obj.mesh->drawGeometry(shader.ID, obj.modelMatrix);
+        instancedShader.use();
+        for (const InstanceBatch &batch : instanceBatches)
+            batch.group->mesh->drawGeometryInstanced(instanceBuffer.getID(), batch.firstInstance, batch.count,
+                                                     batch.lod);
+        shader.use();
     }
 
     // 注意：天体和天空盒不需要投射阴影，这里跳过
 }
 
+void Scene::cull(const Frustum &frustum)
+{
+    frustum.cull(objectBounds, objectVisibility);
+    for (size_t i = 0; i < renderQueue.size(); i++)
+        renderQueue[i].visible = objectVisibility[i] != 0;
+    groundVisible = frustum.intersects(groundBounds);
+}
+
+void Scene::buildInstanceGroups()
+{
+    instanceGroups.clear();
+    std::map<std::pair<const TriMesh *, bool>, size_t> groupOf;
+    for (size_t i = 0; i < renderQueue.size(); i++)
+    {
+        const SceneObject &obj = renderQueue[i];
+        auto key = std::make_pair(obj.mesh.get(), obj.receivesShadows);
+        auto it = groupOf.find(key);
+        if (it == groupOf.end())
+        {
+            it = groupOf.emplace(key, instanceGroups.size()).first;
+            InstanceGroup group;
+            group.mesh = obj.mesh;
+            group.receivesShadows = obj.receivesShadows;
+            instanceGroups.push_back(group);
+        }
+        instanceGroups[it->second].objects.push_back(i);
+    }
+}
+
+void Scene::prepareInstanceBatches(bool mainPass, const glm::vec3 &cameraPos)
+{
+    instanceMatrices.clear();
+    instanceBatches.clear();
+
+    // 同一组里 LOD 相同的物体排在一起，一段对应一次绘制
+    for (const InstanceGroup &group : instanceGroups)
+    {
+        for (int lod = 0; lod < group.mesh->getLodCount(); lod++)
+        {
+            GLsizei first = static_cast<GLsizei>(instanceMatrices.size());
+            float nearest = std::numeric_limits<float>::max();
+            for (size_t index : group.objects)
+            {
+                const SceneObject &obj = renderQueue[index];
+                if (obj.lod != lod)
+                    continue;
+                if (mainPass ? (!obj.visible || obj.usingImpostor) : (!obj.castsShadows || !shadowVisibility[index]))
+                    continue;
+                instanceMatrices.push_back(obj.modelMatrix);
+                nearest = std::min(nearest, std::max(glm::length(obj.worldCenter - cameraPos) - obj.boundingRadius, 0.0f));
+            }
+            GLsizei count = static_cast<GLsizei>(instanceMatrices.size()) - first;
+            if (count > 0)
+                instanceBatches.push_back({&group, lod, first, count, nearest});
+        }
+    }
+
+    instanceBuffer.upload(instanceMatrices);
+}
+
+int Scene::selectLod(int currentLod, int lodCount, float screenSize)
+{
+    // 不考虑迟滞时的目标级别
+    int target = 0;
+    while (target + 1 < lodCount && target < LOD_THRESHOLD_COUNT && screenSize < LOD_SCREEN_THRESHOLDS[target])
+        target++;
+
+    int current = std::min(currentLod, lodCount - 1);
+    if (target > current)
+    {
+        // 变粗：必须明显低于阈值
+        while (target > current && screenSize >= LOD_SCREEN_THRESHOLDS[target - 1] * (1.0f - LOD_HYSTERESIS))
+            target--;
+    }
+    else if (target < current)
+    {
+        // 变细：必须明显高于阈值
+        while (target < current && screenSize <= LOD_SCREEN_THRESHOLDS[target] * (1.0f + LOD_HYSTERESIS))
+            target++;
+    }
+    return target;
+}
+
+std::shared_ptr<Impostor> Scene::getImpostor(const std::shared_ptr<TriMesh> &mesh)
+{
+    auto it = impostors.find(mesh.get());
+    if (it != impostors.end())
+        return it->second;
+
+    // 替身会一直缓存下去，不能用占位白图烘焙：流式模式下先等贴图上传完
+    if (mesh->hasPendingTextures())
+        ResourceManager::getInstance().getTextureStreamer().flush();
+
+    auto impostor = std::make_shared<Impostor>();
+    if (!impostor->bake(*mesh, *impostorBakeShader))
+        impostor = nullptr;
+    // 失败也记下来，避免每个物体都重新烘焙一次
+    impostors[mesh.get()] = impostor;
+    return impostor;
+}
+
+bool Scene::shouldUseImpostor(bool current, float distance) const
+{
+    if (current)
+        return distance > impostorDistance * (1.0f - IMPOSTOR_HYSTERESIS);
+    return distance > impostorDistance * (1.0f + IMPOSTOR_HYSTERESIS);
+}
+
 void Scene::drawCelestialBody(std::shared_ptr<TriMesh> mesh, Shader &shader,
-                              LightManager *lights, bool isSun)
+                              LightManager *lights, bool isSun, const glm::vec3 &cameraPos)
 {
     // 1. 获取配置 (完全解耦！Scene 不再关心现在是白天还是晚上)
     const CelestialConfig &config = isSun ? lights->getSunConfig() : lights->getMoonConfig();
@@ -235,13 +481,29 @@ void Scene::drawCelestialBody(std::shared_ptr<TriMesh> mesh, Shader &shader,
 
     model = glm::scale(model, glm::vec3(config.scale));
 
+    // 天体离得很远，超过替身距离时画面片 (发光参数同样设置在替身着色器上)
+    const std::shared_ptr<Impostor> &impostor = isSun ? sunImpostor : moonImpostor;
+    bool &usingImpostor = isSun ? sunUsingImpostor : moonUsingImpostor;
+    usingImpostor = impostor && shouldUseImpostor(usingImpostor, glm::length(pos - cameraPos));
+    bool useImpostor = usingImpostor;
+    Shader &target = useImpostor ? *impostorShader : shader;
+    if (useImpostor)
+        impostorShader->use();
+
     // 4. 应用发光参数 (从 config 读取，不再硬编码 0.8/0.9)
-    shader.setVec3("dirLight.ambient", config.emissionAmbient);
-    shader.setVec3("dirLight.diffuse", config.emissionDiffuse);
+    // 光照 UBO 是所有物体共享的，这里用着色器自己的 emissive 开关覆盖方向光
+    target.set(U_EMISSIVE, true);
+    target.set(U_EMISSION_AMBIENT, config.emissionAmbient);
+    target.set(U_EMISSION_DIFFUSE, config.emissionDiffuse);
 
     // 5. 绘制
-    mesh->draw(shader.ID, model);
+    if (useImpostor)
+        impostor->draw(*impostorShader, model, cameraPos);
+    else
+        mesh->draw(shader, model);
 
-    // 6. 恢复现场 (依然调用 apply 重置为全局光照)
-    lights->apply(shader);
+    // 6. 恢复现场 (关掉自发光，回到全局光照)
+    target.set(U_EMISSIVE, false);
+    if (useImpostor)
+        shader.use();
 }
\ No newline at end of file
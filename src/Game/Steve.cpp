@@ -32,6 +32,13 @@ void Steve::init(const std::string& characterName) {
     std::string basePath = "assets/models/" + characterName + "/";
     // 使用 ResourceManager 获取资源
     // 即使你创建 10 个 Steve，它们现在共享同一份内存中的 Vertex Data
+    auto& resources = ResourceManager::getInstance();
+    // 先把所有部件交给后台线程并行解析，下面的 getMesh 只需等待并上传
+    static const char* parts[] = {"body.obj", "head.obj", "left_arm.obj", "right_arm.obj",
+                                  "left_leg.obj", "right_leg.obj"};
+    for (const char* part : parts) resources.getMeshAsync(basePath + part);
+    resources.getMeshAsync("assets/models/diamond_sword/model.obj", VertexFormat::Compact, true);
+
     torso    = ResourceManager::getInstance().getMesh(basePath + "body.obj");
     head     = ResourceManager::getInstance().getMesh(basePath + "head.obj");
     leftArm  = ResourceManager::getInstance().getMesh(basePath + "left_arm.obj");
@@ -39,7 +46,9 @@ void Steve::init(const std::string& characterName) {
     leftLeg  = ResourceManager::getInstance().getMesh(basePath + "left_leg.obj");
     rightLeg = ResourceManager::getInstance().getMesh(basePath + "right_leg.obj");
 
-    sword    = ResourceManager::getInstance().getMesh("assets/models/diamond_sword/model.obj");
+    // 钻石剑是纯色方块拼成的，开启共面合并
+    sword    = ResourceManager::getInstance().getMesh("assets/models/diamond_sword/model.obj",
+                                                      VertexFormat::Compact, true);
 }
 
 AABB Steve::getBoundingBox() const {
@@ -49,6 +58,11 @@ AABB Steve::getBoundingBox() const {
     return AABB(position, glm::vec3(w, h, w));
 }
 
+AABB Steve::getRenderBounds() const {
+    // 身体中心在 position，剑举过头顶或向前伸时都不超过 1.5 格
+    return AABB(position + glm::vec3(0.0f, 0.3f, 0.0f), glm::vec3(3.0f, 3.2f, 3.0f));
+}
+
 void Steve::update(float dt, const SteveInput& input,
                    const std::vector<AABB>& obstacles,
                    AABB otherPlayerBox) {
@@ -216,7 +230,7 @@ void Steve::updateAnimation(float dt) {
     }
 }
 
-void Steve::draw(Shader& shader) {
+void Steve::draw(RenderQueue& queue, const Shader& opaqueShader, const Shader& alphaTestShader) {
 
     // 1. 动画参数计算
     // 基础行走摆动 (基于 walkTime)
@@ -242,14 +256,13 @@ void Steve::draw(Shader& shader) {
     glm::vec3 standardAxis  = glm::vec3(1.0f, 0.0f, 0.0f);
 
     // [Level 1] 躯干
-    // 只传 ID 和 Model
-    torso->draw(shader.ID, model);
+    queuePart(queue, *torso, opaqueShader, alphaTestShader, model);
 
     // [Level 2] 头部
     glm::mat4 headModel = model;
     headModel = glm::translate(headModel, glm::vec3(0.0f, 0.37f, 0.0f));
     headModel = glm::rotate(headModel, glm::radians(headYaw), glm::vec3(0.0f, 1.0f, 0.0f));
-    head->draw(shader.ID, headModel);
+    queuePart(queue, *head, opaqueShader, alphaTestShader, headModel);
 
     // [Level 2] 右大臂
     glm::mat4 rightUpperModel = model;
@@ -257,7 +270,7 @@ void Steve::draw(Shader& shader) {
     rightUpperModel = glm::rotate(rightUpperModel, glm::radians(rightArmTargetAngle), armRotateAxis);
 
     glm::mat4 upperDrawModel = glm::scale(rightUpperModel, glm::vec3(1.0f, 0.5f, 1.0f));
-    rightArm->draw(shader.ID, upperDrawModel);
+    queuePart(queue, *rightArm, opaqueShader, alphaTestShader, upperDrawModel);
 
     // [Level 3] 右小臂
     glm::mat4 rightLowerModel = rightUpperModel;
@@ -269,7 +282,7 @@ void Steve::draw(Shader& shader) {
     rightLowerModel = glm::rotate(rightLowerModel, glm::radians(elbowBend), armRotateAxis);
 
     glm::mat4 lowerDrawModel = glm::scale(rightLowerModel, glm::vec3(1.0f, 0.5f, 1.0f));
-    rightArm->draw(shader.ID, lowerDrawModel);
+    queuePart(queue, *rightArm, opaqueShader, alphaTestShader, lowerDrawModel);
 
     // [Level 4] 钻石剑
     glm::mat4 swordModel = rightLowerModel;
@@ -279,12 +292,12 @@ void Steve::draw(Shader& shader) {
     if (isArmRaised) swordModel = glm::rotate(swordModel, glm::radians(45.0f), armRotateAxis);
     swordModel = glm::translate(swordModel, glm::vec3(0.0f, 0.35f, 0.0f));
     swordModel = glm::scale(swordModel, glm::vec3(1.5f));
-    sword->draw(shader.ID, swordModel);
+    queuePart(queue, *sword, opaqueShader, alphaTestShader, swordModel);
 
     // 其他肢体
-    drawLimb(leftArm, shader, model, glm::vec3(-0.375f, 0.375f, 0.0f), swingAngle, standardAxis);
-    drawLimb(leftLeg, shader, model, glm::vec3(-0.125f, -0.375f, 0.0f), -swingAngle, standardAxis);
-    drawLimb(rightLeg, shader, model, glm::vec3(0.125f, -0.375f, 0.0f), swingAngle, standardAxis);
+    drawLimb(queue, leftArm, opaqueShader, alphaTestShader, model, glm::vec3(-0.375f, 0.375f, 0.0f), swingAngle, standardAxis);
+    drawLimb(queue, leftLeg, opaqueShader, alphaTestShader, model, glm::vec3(-0.125f, -0.375f, 0.0f), -swingAngle, standardAxis);
+    drawLimb(queue, rightLeg, opaqueShader, alphaTestShader, model, glm::vec3(0.125f, -0.375f, 0.0f), swingAngle, standardAxis);
 }
 
 // 阴影生成 Pass
@@ -307,25 +320,25 @@ void Steve::drawShadow(Shader& shader) {
     glm::vec3 standardAxis  = glm::vec3(1.0f, 0.0f, 0.0f);
 
     // 绘制身体部件 (使用 drawGeometry)
-    torso->drawGeometry(shader.ID, model);
+    torso->drawGeometry(shader, model);
 
     glm::mat4 headModel = model;
     headModel = glm::translate(headModel, glm::vec3(0.0f, 0.37f, 0.0f));
     headModel = glm::rotate(headModel, glm::radians(headYaw), glm::vec3(0.0f, 1.0f, 0.0f));
-    head->drawGeometry(shader.ID, headModel);
+    head->drawGeometry(shader, headModel);
 
     // 右臂层级
     glm::mat4 rightUpperModel = model;
     rightUpperModel = glm::translate(rightUpperModel, glm::vec3(0.375f, 0.375f, 0.0f));
     rightUpperModel = glm::rotate(rightUpperModel, glm::radians(rightArmTargetAngle), armRotateAxis);
-    rightArm->drawGeometry(shader.ID, glm::scale(rightUpperModel, glm::vec3(1.0f, 0.5f, 1.0f)));
+    rightArm->drawGeometry(shader, glm::scale(rightUpperModel, glm::vec3(1.0f, 0.5f, 1.0f)));
 
     glm::mat4 rightLowerModel = rightUpperModel;
     rightLowerModel = glm::translate(rightLowerModel, glm::vec3(0.0f, -0.375f, 0.0f));
     float elbowBend = -20.0f + sin(walkTime * 10.0f) * 10.0f;
     if (isArmRaised) elbowBend = -10.0f;
     rightLowerModel = glm::rotate(rightLowerModel, glm::radians(elbowBend), armRotateAxis);
-    rightArm->drawGeometry(shader.ID, glm::scale(rightLowerModel, glm::vec3(1.0f, 0.5f, 1.0f)));
+    rightArm->drawGeometry(shader, glm::scale(rightLowerModel, glm::vec3(1.0f, 0.5f, 1.0f)));
 
     glm::mat4 swordModel = rightLowerModel;
     swordModel = glm::translate(swordModel, glm::vec3(0.0f, -0.375f, 0.0f));
@@ -334,14 +347,14 @@ void Steve::drawShadow(Shader& shader) {
     if (isArmRaised) swordModel = glm::rotate(swordModel, glm::radians(45.0f), armRotateAxis);
     swordModel = glm::translate(swordModel, glm::vec3(0.0f, 0.35f, 0.0f));
     swordModel = glm::scale(swordModel, glm::vec3(1.5f));
-    sword->drawGeometry(shader.ID, swordModel);
+    sword->drawGeometry(shader, swordModel);
 
     // 其他肢体。手动展开 drawGeometry 调用
     auto drawLimbShadow = [&](std::shared_ptr<TriMesh> mesh, glm::vec3 offset, float angle) {
         glm::mat4 m = model;
         m = glm::translate(m, offset);
         m = glm::rotate(m, glm::radians(angle), standardAxis);
-        mesh->drawGeometry(shader.ID, m);
+        mesh->drawGeometry(shader, m);
     };
 
     drawLimbShadow(leftArm, glm::vec3(-0.375f, 0.375f, 0.0f), swingAngle);
@@ -350,13 +363,24 @@ void Steve::drawShadow(Shader& shader) {
 }
 
 // 辅助函数
-void Steve::drawLimb(const std::shared_ptr<TriMesh>& mesh, Shader& shader,
+void Steve::drawLimb(RenderQueue& queue, const std::shared_ptr<TriMesh>& mesh,
+                     const Shader& opaqueShader, const Shader& alphaTestShader,
                      glm::mat4 parentModel, glm::vec3 offset, float angle,
                      glm::vec3 rotateAxis)
 {
     glm::mat4 limbModel = parentModel;
     limbModel = glm::translate(limbModel, offset);
     limbModel = glm::rotate(limbModel, glm::radians(angle), rotateAxis);
-    // 只传 ID 和 Model
-    mesh->draw(shader.ID, limbModel);
+    queuePart(queue, *mesh, opaqueShader, alphaTestShader, limbModel);
+}
+
+void Steve::queuePart(RenderQueue& queue, const TriMesh& mesh, const Shader& opaqueShader,
+                      const Shader& alphaTestShader, const glm::mat4& model)
+{
+    // 只有漫反射贴图带透明像素的部件才走 alpha test，其余保留提前深度测试
+    // (每次都重新判断：流式纹理解码完成后才知道有没有透明像素)
+    if (mesh.hasAlphaTexture())
+        queue.draw(RenderQueue::PASS_ALPHA_TEST, alphaTestShader, mesh, model);
+    else
+        queue.draw(RenderQueue::PASS_OPAQUE, opaqueShader, mesh, model);
 }
\ No newline at end of file
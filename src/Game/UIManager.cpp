@@ -1,5 +1,6 @@
 #include "Game/UIManager.h"
 #include "Game/Game.h"
+#include "Core/GLState.h"
 
 // 定义统一的菜单宽度，保证切换页面时窗口大小不跳变
 static const float MENU_WIDTH = 700.0f;
@@ -66,6 +67,8 @@ void UIManager::Render(Game &game)
     // 渲染指令提交
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    // ImGui 后端直接调用 GL 改了程序/VAO/纹理，缓存作废
+    GLState::invalidate();
 }
 
 // === 辅助逻辑实现 ===
@@ -257,6 +260,8 @@ void UIManager::RenderHUD(Game &game)
 
     ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "FPS: %.1f", ImGui::GetIO().Framerate);
     ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 0.7f), "Press ESC to Pause");
+    const GLState::Counters &glCalls = GLState::getLastFrameCounters();
+    ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 0.7f), "GL calls: %u issued / %u elided", glCalls.issued, glCalls.elided);
 
     // 如果开启了跟随模式，显示一个提示
     if (game.isFollowing)
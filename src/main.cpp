@@ -3,6 +3,7 @@
 #include <iostream>
 #include "Game/Game.h"
 #include <stb_image.h>
+#include "Core/EmbeddedAssets.h"
 // --- 全局变量 ---
 Game* steveGame = nullptr;
 
@@ -25,6 +26,15 @@ void onWindowResize(GLFWwindow* window, int width, int height);
 void onMouseMove(GLFWwindow* window, double xpos, double ypos);
 void onMouseScroll(GLFWwindow* window, double xoffset, double yoffset);
 
+// 图标优先从嵌入资源解码，没有再读磁盘
+static unsigned char* loadIcon(const char* path, int* width, int* height) {
+    int channels;
+    if (const EmbeddedAssets::Entry* entry = EmbeddedAssets::find(path)) {
+        return stbi_load_from_memory(entry->data, static_cast<int>(entry->size), width, height, &channels, 4);
+    }
+    return stbi_load(path, width, height, &channels, 4);
+}
+
 int main()
 {
     // 1. GLFW 初始化
@@ -49,12 +59,11 @@ int main()
     // ====================================================
     {
         GLFWimage images[2]; // 准备两个槽位
-        int channels;
 
         // 加载一张大图 (48x48 或 64x64) 用于 Alt-Tab 和大图标
-        images[0].pixels = stbi_load("assets/icon_large.png", &images[0].width, &images[0].height, &channels, 4);
+        images[0].pixels = loadIcon("assets/icon_large.png", &images[0].width, &images[0].height);
         // 加载一张小图 (16x16 或 32x32) 专门供任务栏和标题栏使用
-        images[1].pixels = stbi_load("assets/icon_small.png", &images[1].width, &images[1].height, &channels, 4);
+        images[1].pixels = loadIcon("assets/icon_small.png", &images[1].width, &images[1].height);
 
         if (images[0].pixels && images[1].pixels) {
             glfwSetWindowIcon(window, 2, images); // 数量改为 2